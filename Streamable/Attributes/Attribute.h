@@ -0,0 +1,91 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "Streams/StreamReader.h"
+#include "Streams/StreamWriter.h"
+
+namespace hbann
+{
+/*
+    Base of the field attributes
+
+    An attribute wraps a field in STREAMABLE_DEFINE and changes how it is (de)serialized, ex.:
+        STREAMABLE_DEFINE(Telemetry, mID, ::hbann::XorCompressed(mSamples))
+
+    It must implement the templates 'ToStream(Writer &)' and 'FromStream(Reader &)' and it can use the helpers below to
+   reach the writer/reader internals.
+*/
+class Attribute
+{
+  protected:
+    using span = std::span<const uint8_t>;
+
+    template <typename WriterOrReader> using strings_t = typename WriterOrReader::strings;
+
+    template <typename Writer> static inline void WriteCount(Writer &aStreamWriter, const Size::size_max aCount)
+    {
+        aStreamWriter.WriteCount(aCount);
+    }
+
+    template <typename Writer> static constexpr void WriteBytes(Writer &aStreamWriter, const span aBytes)
+    {
+        aStreamWriter.mStream->Write(aBytes);
+    }
+
+    template <typename Writer>
+    static inline Size::size_max WriteRegion(Writer &aStreamWriter, File &aFile, const Size::size_max aOffset,
+                                             const Size::size_max aSize)
+    {
+        return aStreamWriter.mStream->WriteRegion(aFile, aOffset, aSize);
+    }
+
+    // the attributes write temporaries so nothing written by them is referenced by a gather
+    template <typename Writer, typename Type> static constexpr void Write(Writer &aStreamWriter, Type &aObject)
+    {
+        const auto referable = std::exchange(aStreamWriter.mReferable, false);
+        aStreamWriter.Write(aObject);
+        aStreamWriter.mReferable = referable;
+    }
+
+    template <typename Reader> [[nodiscard]] static inline Size::size_max ReadCount(Reader &aStreamReader) noexcept
+    {
+        return aStreamReader.ReadCount();
+    }
+
+    template <typename Reader>
+    [[nodiscard]] static constexpr span ReadBytes(Reader &aStreamReader, const Size::size_max aSize)
+    {
+        return aStreamReader.mStream->Read(aSize);
+    }
+
+    // the count of the bytes left to read, the maximum when they are not known before they are read (ex.: a pipe)
+    template <typename Reader> [[nodiscard]] static constexpr Size::size_max GetSizeLeft(Reader &aStreamReader) noexcept
+    {
+        return aStreamReader.mStream->GetSizeLeft();
+    }
+
+    template <typename Reader>
+    static inline Size::size_max ReadRegion(Reader &aStreamReader, File &aFile, const Size::size_max aOffset,
+                                            const Size::size_max aSize)
+    {
+        return aStreamReader.mStream->ReadRegion(aFile, aOffset, aSize);
+    }
+
+    template <typename Reader, typename Type> static constexpr void Read(Reader &aStreamReader, Type &aObject)
+    {
+        aStreamReader.Read(aObject);
+    }
+
+    // the string table of the Dictionary attribute being (de)serialized or nullptr
+    template <typename WriterOrReader>
+    [[nodiscard]] static constexpr auto &GetStrings(WriterOrReader &aStreamWriterOrReader) noexcept
+    {
+        return aStreamWriterOrReader.mStrings;
+    }
+};
+} // namespace hbann
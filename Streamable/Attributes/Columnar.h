@@ -0,0 +1,208 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "Attribute.h"
+
+namespace hbann
+{
+/*
+    Stores a range of streamables or structs column by column (struct of arrays) instead of element by element, ex.:
+        STREAMABLE_DEFINE(Scene, ::hbann::Columnar(mShapes), ::hbann::Columnar(mPoints, &Point::x, &Point::y))
+
+    The columns of a streamable are the fields (and attributes) from its STREAMABLE_DEFINE and its bases are written
+   per element as a blob before the columns. The columns of a struct are the given data members. The columns of
+   arithmetic/enum/standard layout fields are written in bulk and compress much better, the other ones are written
+   field after field.
+
+    Format: count + (bases blob for each element) + the columns in order
+*/
+template <typename Type, typename... Members> class Columnar : public Attribute
+{
+    using TypeValueType = typename Type::value_type;
+
+    static_assert(requires(Type &aRange) { aRange.resize(0); }, "Type is not a resizable range!");
+    static_assert(sizeof...(Members) || std::derived_from<TypeValueType, IStreamable>,
+                  "Type is not a range of streamables and there are no members for its columns!");
+    static_assert((std::is_member_object_pointer_v<Members> && ...), "Members are not data member pointers!");
+
+    static constexpr auto FindFieldsCount() noexcept
+    {
+        if constexpr (sizeof...(Members))
+        {
+            return sizeof...(Members);
+        }
+        else
+        {
+            using TypeFields = decltype(std::declval<TypeValueType &>().StreamableApply(
+                [](auto &&...aFields) { return std::forward_as_tuple(aFields...); }));
+            return std::tuple_size_v<TypeFields>;
+        }
+    }
+
+    static constexpr auto HasBases() noexcept
+    {
+        return requires { typename TypeValueType::streamable_bases; };
+    }
+
+  public:
+    constexpr explicit Columnar(Type &aRange, const Members... aMembers) noexcept
+        : mRange(aRange), mMembers(aMembers...)
+    {
+    }
+
+    template <typename Writer> constexpr void ToStream(Writer &aStreamWriter)
+    {
+        WriteCount(aStreamWriter, SizeFinder::GetRangeCount(mRange));
+
+        if constexpr (HasBases())
+        {
+            for (auto &element : mRange)
+            {
+                auto stream = WriteBases(element);
+                const auto streamView = stream.View();
+
+                WriteCount(aStreamWriter, streamView.size());
+                WriteBytes(aStreamWriter, streamView);
+            }
+        }
+
+        [&]<size_t... vIndexes>(std::index_sequence<vIndexes...>) {
+            (WriteColumn<vIndexes>(aStreamWriter), ...);
+        }(std::make_index_sequence<FindFieldsCount()>{});
+    }
+
+    template <typename Reader> constexpr void FromStream(Reader &aStreamReader)
+    {
+        // the count can't be trusted (ex.: a corrupted file) and every element takes at least a byte so no more are
+        // allocated than the bytes left
+        const auto count = ReadCount(aStreamReader);
+        mRange.clear();
+        mRange.resize(std::min(count, GetSizeLeft(aStreamReader)));
+
+        if constexpr (HasBases())
+        {
+            for (auto &element : mRange)
+            {
+                ReadBases(element, ReadBytes(aStreamReader, ReadCount(aStreamReader)));
+            }
+        }
+
+        [&]<size_t... vIndexes>(std::index_sequence<vIndexes...>) {
+            (ReadColumn<vIndexes>(aStreamReader), ...);
+        }(std::make_index_sequence<FindFieldsCount()>{});
+    }
+
+  private:
+    Type &mRange;
+    std::tuple<Members...> mMembers{};
+
+    template <size_t vIndex, typename Function> constexpr void ApplyField(TypeValueType &aElement, Function &&aFunction)
+    {
+        if constexpr (sizeof...(Members))
+        {
+            aFunction(aElement.*std::get<vIndex>(mMembers));
+        }
+        else
+        {
+            aElement.StreamableApply([&](auto &&...aFields) {
+                auto &&field = std::get<vIndex>(std::forward_as_tuple(aFields...));
+                aFunction(field);
+            });
+        }
+    }
+
+    template <size_t vIndex> static constexpr auto GetFieldType() noexcept
+    {
+        if constexpr (sizeof...(Members))
+        {
+            using TypeMember = std::tuple_element_t<vIndex, std::tuple<Members...>>;
+            return std::type_identity<std::remove_cvref_t<decltype(std::declval<TypeValueType &>().*
+                                                                   std::declval<TypeMember>())>>{};
+        }
+        else
+        {
+            using TypeFields = decltype(std::declval<TypeValueType &>().StreamableApply(
+                [](auto &&...aFields) { return std::forward_as_tuple(aFields...); }));
+            return std::type_identity<std::remove_cvref_t<std::tuple_element_t<vIndex, TypeFields>>>{};
+        }
+    }
+
+    // the fields written as objects of known size are gathered in a vector and written in bulk (vector<bool> is not
+    // contiguous)
+    template <typename Field> static constexpr auto IsColumnContiguous() noexcept
+    {
+        return (is_object_of_known_size<Field> || is_array_of_known_size<Field>) && !std::is_same_v<Field, bool>;
+    }
+
+    template <size_t vIndex, typename Writer> constexpr void WriteColumn(Writer &aStreamWriter)
+    {
+        using TypeField = typename decltype(GetFieldType<vIndex>())::type;
+
+        if constexpr (IsColumnContiguous<TypeField>())
+        {
+            std::vector<TypeField> column{};
+            column.reserve(SizeFinder::GetRangeCount(mRange));
+            for (auto &element : mRange)
+            {
+                ApplyField<vIndex>(element, [&](auto &aField) { column.push_back(aField); });
+            }
+
+            Write(aStreamWriter, column);
+        }
+        else
+        {
+            for (auto &element : mRange)
+            {
+                ApplyField<vIndex>(element, [&](auto &aField) { Write(aStreamWriter, aField); });
+            }
+        }
+    }
+
+    template <size_t vIndex, typename Reader> constexpr void ReadColumn(Reader &aStreamReader)
+    {
+        using TypeField = typename decltype(GetFieldType<vIndex>())::type;
+
+        if constexpr (IsColumnContiguous<TypeField>())
+        {
+            std::vector<TypeField> column{};
+            Read(aStreamReader, column);
+            if (column.size() != mRange.size())
+            {
+                throw std::length_error("The column doesn't have a value for each element!");
+            }
+
+            auto value = column.begin();
+            for (auto &element : mRange)
+            {
+                ApplyField<vIndex>(element, [&](auto &aField) { aField = *value++; });
+            }
+        }
+        else
+        {
+            for (auto &element : mRange)
+            {
+                ApplyField<vIndex>(element, [&](auto &aField) { Read(aStreamReader, aField); });
+            }
+        }
+    }
+
+    static constexpr Stream WriteBases(TypeValueType &aElement)
+    {
+        aElement.Swap(Stream());
+        aElement.ToStreamBases();
+        return aElement.Release();
+    }
+
+    static constexpr void ReadBases(TypeValueType &aElement, const span aBytes)
+    {
+        aElement.Swap(static_cast<Stream>(aBytes));
+        aElement.FromStreamBases();
+        aElement.Swap(Stream());
+    }
+};
+} // namespace hbann
@@ -0,0 +1,59 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "Attribute.h"
+
+namespace hbann
+{
+/*
+    Writes every std::string inside the field (ranges, maps, tuples etc...) only once, the next copies are written as
+   references to the first one and are copied from it on read, ex.:
+        STREAMABLE_DEFINE(Log, mID, ::hbann::Dictionary(mTags))
+
+    The nested dictionaries share the table of the outermost one. The nested streamables are not included because they
+   are serialized by their own writers.
+
+    Format: every string starts with a count that is 0 for a new string (followed by the string) or its index + 1
+*/
+template <typename Type> class Dictionary : public Attribute
+{
+  public:
+    constexpr explicit Dictionary(Type &aObject) noexcept : mObject(aObject)
+    {
+    }
+
+    template <typename Writer> constexpr void ToStream(Writer &aStreamWriter)
+    {
+        WithStrings(aStreamWriter, [&] { Write(aStreamWriter, mObject); });
+    }
+
+    template <typename Reader> constexpr void FromStream(Reader &aStreamReader)
+    {
+        WithStrings(aStreamReader, [&] { Read(aStreamReader, mObject); });
+    }
+
+  private:
+    Type &mObject;
+
+    template <typename WriterOrReader, typename Function>
+    static constexpr void WithStrings(WriterOrReader &aStreamWriterOrReader, Function &&aFunction)
+    {
+        auto &strings = GetStrings(aStreamWriterOrReader);
+        if (strings)
+        {
+            aFunction();
+            return;
+        }
+
+        strings_t<WriterOrReader> table{};
+        strings = &table;
+        aFunction();
+        strings = nullptr;
+    }
+};
+} // namespace hbann
@@ -0,0 +1,106 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "Attribute.h"
+
+namespace hbann
+{
+/*
+    A region of a file (de)serialized as its bytes without reading them into memory, ex.:
+        ::hbann::FileRegion mContent{path};
+        STREAMABLE_DEFINE(Artifact, mName, mContent)
+
+    The bytes are read from the file when serializing and written to it (at the offset) when deserializing. When the
+   stream is a file or a descriptor they are moved in the kernel (copy_file_range/sendfile/splice on Linux) and the
+   other streams copy them through a buffer.
+
+    Format: size + bytes (like a std::vector<uint8_t>)
+*/
+class FileRegion : public Attribute
+{
+  public:
+    static inline constexpr Size::size_max SIZE_ALL = std::numeric_limits<Size::size_max>::max();
+
+    FileRegion() noexcept = default;
+
+    // the file is opened only while the region is (de)serialized
+    explicit FileRegion(const std::filesystem::path &aPath, const Size::size_max aOffset = 0,
+                        const Size::size_max aSize = SIZE_ALL)
+        : mPath(aPath), mOffset(aOffset), mSizeRequested(aSize), mSize(aSize)
+    {
+    }
+
+    // a file opened by someone else that is not closed by the region
+    explicit FileRegion(const File::handle aHandle, const Size::size_max aOffset = 0,
+                        const Size::size_max aSize = SIZE_ALL) noexcept
+        : mHandle(aHandle), mOffset(aOffset), mSizeRequested(aSize), mSize(aSize)
+    {
+    }
+
+    [[nodiscard]] constexpr Size::size_max GetOffset() const noexcept
+    {
+        return mOffset;
+    }
+
+    // the size of the region at the last (de)serialization, it is measured again every time the region is the rest of
+    // the file
+    [[nodiscard]] constexpr Size::size_max GetSize() const noexcept
+    {
+        return mSize;
+    }
+
+    template <typename Writer> void ToStream(Writer &aStreamWriter)
+    {
+        auto file = Open(StreamUsageType::DESERIALIZE);
+        const auto fileSize = file.GetSize();
+        mSize = std::min(mSizeRequested, fileSize - std::min(mOffset, fileSize));
+
+        WriteCount(aStreamWriter, mSize);
+
+        // the file shrank after it was measured so the missing bytes are written as zeros to keep the stream readable
+        static constexpr std::array<uint8_t, 4096> zeros{};
+        for (auto size = WriteRegion(aStreamWriter, file, mOffset, mSize); size < mSize; size += zeros.size())
+        {
+            WriteBytes(aStreamWriter, span(zeros).first(std::min(zeros.size(), mSize - size)));
+        }
+
+        Close(file);
+    }
+
+    template <typename Reader> void FromStream(Reader &aStreamReader)
+    {
+        auto file = Open(StreamUsageType::SERIALIZE);
+        // the stream can end before the region (ex.: a truncated file)
+        mSize = ReadRegion(aStreamReader, file, mOffset, ReadCount(aStreamReader));
+
+        Close(file);
+    }
+
+  private:
+    std::filesystem::path mPath{};
+    std::optional<File::handle> mHandle{};
+
+    Size::size_max mOffset{};
+    Size::size_max mSizeRequested = SIZE_ALL;
+    Size::size_max mSize = SIZE_ALL;
+
+    // the file is not truncated when it is written so the bytes around the region are kept
+    [[nodiscard]] File Open(const StreamUsageType aStreamUsageType) const
+    {
+        return mHandle ? File(*mHandle) : File(mPath, aStreamUsageType, true);
+    }
+
+    void Close(File &aFile) const noexcept
+    {
+        if (mHandle)
+        {
+            (void)aFile.Release();
+        }
+    }
+};
+} // namespace hbann
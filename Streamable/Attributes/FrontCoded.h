@@ -0,0 +1,129 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "Attribute.h"
+
+namespace hbann
+{
+/*
+    Stores a range of std::string or a map with std::string keys front coded, every key is written as the length of the
+   prefix shared with the previous key + the rest of it, ex.:
+        STREAMABLE_DEFINE(Index, ::hbann::FrontCoded(mFiles), ::hbann::FrontCoded(mURLs))
+
+    The ordered containers (std::set, std::map) share the longest prefixes.
+
+    Format: count + (shared length + suffix length + suffix + mapped value) for each key
+*/
+template <typename Type> class FrontCoded : public Attribute
+{
+    static constexpr auto IsMap() noexcept
+    {
+        return requires { typename Type::mapped_type; };
+    }
+
+    static constexpr auto GetKeyType() noexcept
+    {
+        if constexpr (IsMap())
+        {
+            return std::type_identity<typename Type::key_type>{};
+        }
+        else
+        {
+            return std::type_identity<typename Type::value_type>{};
+        }
+    }
+
+    using TypeKeyType = typename decltype(GetKeyType())::type;
+
+    static_assert(std::ranges::range<Type> && std::is_same_v<TypeKeyType, std::string>,
+                  "Type is not a range of strings or a map with string keys!");
+
+  public:
+    constexpr explicit FrontCoded(Type &aRange) noexcept : mRange(aRange)
+    {
+    }
+
+    template <typename Writer> constexpr void ToStream(Writer &aStreamWriter)
+    {
+        WriteCount(aStreamWriter, SizeFinder::GetRangeCount(mRange));
+
+        std::string_view keyPrevious{};
+        for (auto &element : mRange)
+        {
+            const std::string_view key = GetKey(element);
+
+            const auto length = std::min(key.size(), keyPrevious.size());
+            const Size::size_max shared =
+                std::mismatch(key.begin(), key.begin() + length, keyPrevious.begin()).first - key.begin();
+            WriteCount(aStreamWriter, shared);
+
+            const auto suffix = key.substr(shared);
+            WriteCount(aStreamWriter, suffix.size());
+            WriteBytes(aStreamWriter, {reinterpret_cast<const uint8_t *>(suffix.data()), suffix.size()});
+
+            if constexpr (IsMap())
+            {
+                Write(aStreamWriter, element.second);
+            }
+
+            keyPrevious = key;
+        }
+    }
+
+    template <typename Reader> constexpr void FromStream(Reader &aStreamReader)
+    {
+        // the count can't be trusted (ex.: a corrupted file) and every key takes at least 2 bytes
+        const auto count = std::min(ReadCount(aStreamReader), GetSizeLeft(aStreamReader) / 2);
+
+        mRange.clear();
+
+        std::string key{};
+        for (Size::size_max index = 0; index < count; index++)
+        {
+            const auto shared = ReadCount(aStreamReader);
+            if (shared > key.size())
+            {
+                throw std::length_error("The shared prefix is longer than the previous key!");
+            }
+
+            key.resize(shared);
+
+            const auto suffix = ReadBytes(aStreamReader, ReadCount(aStreamReader));
+            key.append(reinterpret_cast<const char *>(suffix.data()), suffix.size());
+
+            // the keys are sorted already for the ordered containers so we hint the end
+            if constexpr (IsMap())
+            {
+                typename Type::mapped_type value{};
+                Read(aStreamReader, value);
+                mRange.emplace_hint(mRange.end(), key, std::move(value));
+            }
+            else
+            {
+                mRange.insert(mRange.end(), key);
+            }
+        }
+    }
+
+  private:
+    Type &mRange;
+
+    template <typename Element>
+    [[nodiscard]] static constexpr const std::string &GetKey(const Element &aElement) noexcept
+    {
+        if constexpr (IsMap())
+        {
+            return aElement.first;
+        }
+        else
+        {
+            return aElement;
+        }
+    }
+};
+} // namespace hbann
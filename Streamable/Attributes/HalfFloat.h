@@ -0,0 +1,131 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "Attribute.h"
+#include "Utilities/FloatConverter.h"
+
+namespace hbann
+{
+enum class HalfFloatType : uint8_t
+{
+    FLOAT16,
+    BFLOAT16
+};
+
+/*
+    Stores a float/double or a contiguous range of them in 16 bits (lossy)
+
+    Format: the 16 bits value or count + the 16 bits values
+*/
+template <typename Type, HalfFloatType vHalfFloatType> class HalfFloat : public Attribute
+{
+    static constexpr auto IsRange() noexcept
+    {
+        if constexpr (std::ranges::contiguous_range<Type>)
+        {
+            return std::floating_point<typename Type::value_type>;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    static_assert(std::floating_point<Type> || IsRange(), "Type is not a floating point or a range of them!");
+
+  public:
+    constexpr explicit HalfFloat(Type &aObject) noexcept : mObject(aObject)
+    {
+    }
+
+    template <typename Writer> constexpr void ToStream(Writer &aStreamWriter)
+    {
+        if constexpr (IsRange())
+        {
+            using TypeValueType = typename Type::value_type;
+
+            std::vector<uint16_t> halfs(SizeFinder::GetRangeCount(mObject));
+            if constexpr (vHalfFloatType == HalfFloatType::FLOAT16)
+            {
+                FloatConverter::ToFloat16(std::span<const TypeValueType>(mObject), std::span(halfs));
+            }
+            else
+            {
+                FloatConverter::ToBFloat16(std::span<const TypeValueType>(mObject), std::span(halfs));
+            }
+
+            Write(aStreamWriter, halfs);
+        }
+        else
+        {
+            auto half = vHalfFloatType == HalfFloatType::FLOAT16
+                            ? FloatConverter::ToFloat16(mObject)
+                            : FloatConverter::ToBFloat16(mObject);
+            Write(aStreamWriter, half);
+        }
+    }
+
+    template <typename Reader> constexpr void FromStream(Reader &aStreamReader)
+    {
+        if constexpr (IsRange())
+        {
+            using TypeValueType = typename Type::value_type;
+
+            std::vector<uint16_t> halfs{};
+            Read(aStreamReader, halfs);
+
+            // the extra values of a std::array are dropped
+            if constexpr (is_array_v<Type>)
+            {
+                halfs.resize(std::min(halfs.size(), mObject.size()));
+            }
+            else
+            {
+                mObject.resize(halfs.size());
+            }
+
+            const auto values = std::span<TypeValueType>(mObject).first(halfs.size());
+            if constexpr (vHalfFloatType == HalfFloatType::FLOAT16)
+            {
+                FloatConverter::FromFloat16(std::span<const uint16_t>(halfs), values);
+            }
+            else
+            {
+                FloatConverter::FromBFloat16(std::span<const uint16_t>(halfs), values);
+            }
+        }
+        else
+        {
+            uint16_t half{};
+            Read(aStreamReader, half);
+
+            mObject = static_cast<Type>(vHalfFloatType == HalfFloatType::FLOAT16 ? FloatConverter::FromFloat16(half)
+                                                                                 : FloatConverter::FromBFloat16(half));
+        }
+    }
+
+  private:
+    Type &mObject;
+};
+
+template <typename Type> class Float16 : public HalfFloat<Type, HalfFloatType::FLOAT16>
+{
+  public:
+    constexpr explicit Float16(Type &aObject) noexcept : HalfFloat<Type, HalfFloatType::FLOAT16>(aObject)
+    {
+    }
+};
+
+template <typename Type> class BFloat16 : public HalfFloat<Type, HalfFloatType::BFLOAT16>
+{
+  public:
+    constexpr explicit BFloat16(Type &aObject) noexcept : HalfFloat<Type, HalfFloatType::BFLOAT16>(aObject)
+    {
+    }
+};
+} // namespace hbann
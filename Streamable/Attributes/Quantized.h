@@ -0,0 +1,114 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "Attribute.h"
+#include "Utilities/FloatConverter.h"
+
+namespace hbann
+{
+/*
+    Stores a float/double or a contiguous range of them quantized to N bits over [min, max] (lossy)
+
+    Format: the quantized value in (N + 7) / 8 bytes or count + the quantized values packed in (count * N + 7) / 8 bytes
+
+    The values outside [min, max] are clamped and the error is at most (max - min) / (2^N - 1) / 2.
+*/
+template <typename Type> class Quantized : public Attribute
+{
+    static constexpr auto IsRange() noexcept
+    {
+        if constexpr (std::ranges::contiguous_range<Type>)
+        {
+            return std::floating_point<typename Type::value_type>;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    static_assert(std::floating_point<Type> || IsRange(), "Type is not a floating point or a range of them!");
+
+  public:
+    constexpr explicit Quantized(Type &aObject, const uint8_t aBits, const double aMin, const double aMax) noexcept
+        : mObject(aObject), mBits(aBits), mMin(aMin), mMax(aMax)
+    {
+        assert(mBits && mBits <= FloatConverter::QUANTIZE_BITS_MAX && mMin < mMax);
+    }
+
+    template <typename Writer> constexpr void ToStream(Writer &aStreamWriter)
+    {
+        if constexpr (IsRange())
+        {
+            using TypeValueType = typename Type::value_type;
+
+            WriteCount(aStreamWriter, SizeFinder::GetRangeCount(mObject));
+            WriteBytes(aStreamWriter,
+                       FloatConverter::Quantize(std::span<const TypeValueType>(mObject), mBits, mMin, mMax));
+        }
+        else
+        {
+            const Type values[]{mObject};
+            WriteBytes(aStreamWriter, FloatConverter::Quantize(std::span<const Type>(values), mBits, mMin, mMax));
+        }
+    }
+
+    template <typename Reader> constexpr void FromStream(Reader &aStreamReader)
+    {
+        if constexpr (IsRange())
+        {
+            using TypeValueType = typename Type::value_type;
+
+            // the count can't be trusted (ex.: a corrupted file) so the values are read a chunk at a time and no more
+            // are allocated than the bytes read, the extra values of a std::array are dropped
+            const auto count = ReadCount(aStreamReader);
+            if constexpr (!is_array_v<Type>)
+            {
+                mObject.clear();
+            }
+
+            for (Size::size_max index = 0; index < count;)
+            {
+                const auto countChunk = std::min(count - index, CHUNK_COUNT);
+                const auto bytes = ReadBytes(aStreamReader, (countChunk * mBits + 7) / 8);
+                const auto countRead = std::min(countChunk, bytes.size() * 8 / mBits);
+
+                if constexpr (!is_array_v<Type>)
+                {
+                    mObject.resize(index + countRead);
+                }
+
+                const auto countStored = std::min(countRead, mObject.size() - std::min(index, mObject.size()));
+                FloatConverter::Dequantize(bytes, std::span<TypeValueType>(mObject).subspan(index, countStored), mBits,
+                                           mMin, mMax);
+
+                index += countRead;
+                if (countRead < countChunk)
+                {
+                    break;
+                }
+            }
+        }
+        else
+        {
+            const auto bytes = ReadBytes(aStreamReader, (mBits + 7) / 8);
+            FloatConverter::Dequantize(bytes, std::span<Type>(&mObject, 1), mBits, mMin, mMax);
+        }
+    }
+
+  private:
+    // the count of the values read at once, the bytes of a chunk end at a byte boundary because it is a multiple of 8
+    static inline constexpr Size::size_max CHUNK_COUNT = 8 * 1024;
+
+    Type &mObject;
+
+    uint8_t mBits;
+    double mMin;
+    double mMax;
+};
+} // namespace hbann
@@ -0,0 +1,93 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "Attribute.h"
+
+namespace hbann
+{
+/*
+    Stores a range of std::string/std::string_view as the end offsets of the strings + one blob with all the characters,
+   so there are no sizes between the strings and the reading is two bulk reads instead of two per string, ex.:
+        STREAMABLE_DEFINE(Corpus, ::hbann::StringBlob(mWords))
+
+    The std::string_view elements are read in O(1) pointing into the deserialized bytes so they must outlive them (ex.
+   deserialize without clearing from a stream over memory and not from a file).
+
+    Format: offsets (as a range of uint32_t) + blob size + blob, so the blobs bigger than 4GB can't be written and they
+   throw
+*/
+template <typename Type> class StringBlob : public Attribute
+{
+    using TypeValueType = typename Type::value_type;
+
+    static_assert(std::ranges::range<Type> &&
+                      (std::is_same_v<TypeValueType, std::string> || std::is_same_v<TypeValueType, std::string_view>),
+                  "Type is not a range of strings or string views!");
+
+  public:
+    constexpr explicit StringBlob(Type &aRange) noexcept : mRange(aRange)
+    {
+    }
+
+    template <typename Writer> constexpr void ToStream(Writer &aStreamWriter)
+    {
+        std::vector<uint32_t> offsets{};
+        offsets.reserve(SizeFinder::GetRangeCount(mRange));
+
+        Size::size_max offset{};
+        for (const auto &string : mRange)
+        {
+            offset += string.size();
+            if (offset > UINT32_MAX)
+            {
+                throw std::length_error("The blob of the strings doesn't fit in 4GB!");
+            }
+
+            offsets.push_back(static_cast<uint32_t>(offset));
+        }
+
+        Write(aStreamWriter, offsets);
+        WriteCount(aStreamWriter, offset);
+        for (const auto &string : mRange)
+        {
+            WriteBytes(aStreamWriter, {reinterpret_cast<const uint8_t *>(string.data()), string.size()});
+        }
+    }
+
+    template <typename Reader> constexpr void FromStream(Reader &aStreamReader)
+    {
+        std::vector<uint32_t> offsets{};
+        Read(aStreamReader, offsets);
+
+        const auto blob = ReadBytes(aStreamReader, ReadCount(aStreamReader));
+        const auto chars = reinterpret_cast<const char *>(blob.data());
+
+        mRange.clear();
+        if constexpr (requires { mRange.reserve(offsets.size()); })
+        {
+            mRange.reserve(offsets.size());
+        }
+
+        // the strings of corrupted offsets (ex.: after the blob) are not read
+        uint32_t begin{};
+        for (const auto end : offsets)
+        {
+            if (end < begin || end > blob.size())
+            {
+                break;
+            }
+
+            mRange.insert(std::ranges::cend(mRange), TypeValueType(chars + begin, end - begin));
+            begin = end;
+        }
+    }
+
+  private:
+    Type &mRange;
+};
+} // namespace hbann
@@ -0,0 +1,61 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "Attribute.h"
+#include "Utilities/XorCompressor.h"
+
+namespace hbann
+{
+/*
+    Stores a contiguous range of floats/doubles compressed with the XorCompressor
+
+    Format: count + compressed size in bytes + compressed bytes
+*/
+template <typename Type> class XorCompressed : public Attribute
+{
+    static_assert(std::ranges::contiguous_range<Type> && std::floating_point<typename Type::value_type>,
+                  "Type is not a contiguous range of floating points!");
+
+    using TypeValueType = typename Type::value_type;
+
+  public:
+    constexpr explicit XorCompressed(Type &aRange) noexcept : mRange(aRange)
+    {
+    }
+
+    template <typename Writer> constexpr void ToStream(Writer &aStreamWriter)
+    {
+        const auto bytes = XorCompressor::Encode(std::span<const TypeValueType>(mRange));
+
+        WriteCount(aStreamWriter, SizeFinder::GetRangeCount(mRange));
+        WriteCount(aStreamWriter, bytes.size());
+        WriteBytes(aStreamWriter, bytes);
+    }
+
+    template <typename Reader> constexpr void FromStream(Reader &aStreamReader)
+    {
+        const auto count = ReadCount(aStreamReader);
+        const auto bytes = ReadBytes(aStreamReader, ReadCount(aStreamReader));
+
+        // the extra values of a std::array are dropped and the values after a corrupted one are not read
+        if constexpr (is_array_v<Type>)
+        {
+            (void)XorCompressor::Decode(bytes, std::span<TypeValueType>(mRange).first(std::min(count, mRange.size())));
+        }
+        else
+        {
+            // a value takes at least a bit so a corrupted count doesn't allocate more than the bytes can have
+            mRange.resize(std::min(count, bytes.size() * 8));
+            mRange.resize(XorCompressor::Decode(bytes, std::span<TypeValueType>(mRange)));
+        }
+    }
+
+  private:
+    Type &mRange;
+};
+} // namespace hbann
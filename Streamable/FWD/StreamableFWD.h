@@ -6,13 +6,64 @@
 
 #pragma once
 
+#include <bit>
+
+// The size policy of StreamReader/StreamWriter and so of every streamable, define it before including the library to
+// change it (::hbann::Size, ::hbann::SizeFixed or ::hbann::SizeVarint)
+#ifndef STREAMABLE_SIZE_TYPE
+#define STREAMABLE_SIZE_TYPE ::hbann::Size
+#endif // !STREAMABLE_SIZE_TYPE
+
+// The endianness of StreamReader/StreamWriter and so of every streamable, define it as std::endian::little before
+// including the library for a portable format (it costs nothing on little endian platforms)
+#ifndef STREAMABLE_ENDIAN
+#define STREAMABLE_ENDIAN std::endian::native
+#endif // !STREAMABLE_ENDIAN
+
 namespace hbann
 {
+class Attribute;
+class BloomFilter;
+class BitReader;
+class BitWriter;
+class ByteSwapper;
 class Converter;
+class Crc32c;
+class File;
+class FileMapping;
+class FileRegion;
+class FileRing;
+class FloatConverter;
 class IStreamable;
+class LzCompressor;
+class Reflector;
 class Size;
 class SizeFinder;
+class SizeFixed;
+class SizeVarint;
+class StaticStreamable;
 class Stream;
-class StreamReader;
-class StreamWriter;
+class StreamDescriptor;
+class StreamFile;
+class StreamGather;
+class XorCompressor;
+
+template <typename, std::endian = STREAMABLE_ENDIAN> class BasicConstantWriter;
+template <typename, std::endian = STREAMABLE_ENDIAN> class BasicIndexedReader;
+template <typename, std::endian = STREAMABLE_ENDIAN> class BasicIndexedWriter;
+template <typename, std::endian = STREAMABLE_ENDIAN> class BasicRecordReader;
+template <typename, std::endian = STREAMABLE_ENDIAN> class BasicRecordWriter;
+template <typename> class BasicStreamCompressed;
+template <typename, std::endian = STREAMABLE_ENDIAN> class BasicStreamReader;
+template <typename, std::endian = STREAMABLE_ENDIAN> class BasicStreamWriter;
+template <typename, typename...> class Columnar;
+
+using ConstantWriter = BasicConstantWriter<STREAMABLE_SIZE_TYPE>;
+using IndexedReader = BasicIndexedReader<STREAMABLE_SIZE_TYPE>;
+using IndexedWriter = BasicIndexedWriter<STREAMABLE_SIZE_TYPE>;
+using RecordReader = BasicRecordReader<STREAMABLE_SIZE_TYPE>;
+using RecordWriter = BasicRecordWriter<STREAMABLE_SIZE_TYPE>;
+using StreamCompressed = BasicStreamCompressed<Stream>;
+using StreamReader = BasicStreamReader<STREAMABLE_SIZE_TYPE>;
+using StreamWriter = BasicStreamWriter<STREAMABLE_SIZE_TYPE>;
 } // namespace hbann
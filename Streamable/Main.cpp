@@ -28,9 +28,20 @@ constexpr auto LICENSE = R"(/*
 */)"sv;
 
 constexpr auto FILES = {
-    R"(Utilities/Converter.h)"sv,  R"(Utilities/Size.h)"sv,       R"(Streams/StreamFile.h)"sv,
-    R"(Streams/Stream.h)"sv,       R"(Utilities/SizeFinder.h)"sv, R"(Streams/StreamReader.h)"sv,
-    R"(Streams/StreamWriter.h)"sv,
+    R"(Utilities/Converter.h)"sv,    R"(Utilities/Size.h)"sv,           R"(Utilities/SizeFixed.h)"sv,
+    R"(Utilities/SizeVarint.h)"sv,   R"(Utilities/ByteSwapper.h)"sv,    R"(Utilities/BitWriter.h)"sv,
+    R"(Utilities/BitReader.h)"sv,    R"(Utilities/XorCompressor.h)"sv,  R"(Utilities/FloatConverter.h)"sv,
+    R"(Utilities/Reflector.h)"sv,    R"(Utilities/File.h)"sv,           R"(Utilities/FileRing.h)"sv,
+    R"(Utilities/FileMapping.h)"sv,  R"(Utilities/BloomFilter.h)"sv,    R"(Utilities/Crc32c.h)"sv,
+    R"(Utilities/LzCompressor.h)"sv, R"(Streams/StreamDescriptor.h)"sv, R"(Streams/StreamFile.h)"sv,
+    R"(Streams/StreamGather.h)"sv,   R"(Streams/StreamCompressed.h)"sv, R"(Streams/Stream.h)"sv,
+    R"(Utilities/SizeFinder.h)"sv,   R"(Streams/StreamReader.h)"sv,     R"(Streams/StreamWriter.h)"sv,
+    R"(Streams/ConstantWriter.h)"sv, R"(Streams/StaticStreamable.h)"sv, R"(Streams/Serialization.h)"sv,
+    R"(Streams/RecordReader.h)"sv,   R"(Streams/RecordWriter.h)"sv,     R"(Streams/IndexedWriter.h)"sv,
+    R"(Streams/IndexedReader.h)"sv,  R"(Attributes/Attribute.h)"sv,     R"(Attributes/XorCompressed.h)"sv,
+    R"(Attributes/HalfFloat.h)"sv,   R"(Attributes/Quantized.h)"sv,     R"(Attributes/Dictionary.h)"sv,
+    R"(Attributes/FrontCoded.h)"sv,  R"(Attributes/StringBlob.h)"sv,    R"(Attributes/Columnar.h)"sv,
+    R"(Attributes/FileRegion.h)"sv,
 };
 
 constexpr auto FILE_FWD = R"(FWD/StreamableFWD.h)"sv;
@@ -0,0 +1,163 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "Utilities/ByteSwapper.h"
+#include "Utilities/Reflector.h"
+#include "Utilities/SizeFinder.h"
+#include "Utilities/SizeFixed.h"
+#include "Utilities/SizeVarint.h"
+
+namespace hbann
+{
+/*
+    Serializes at compile time exactly like the BasicStreamWriter with the same size policy and endianness, ex.:
+        static constexpr auto TABLE_BYTES = ::hbann::ConstantWriter::Serialize([] { return TABLE; });
+
+    The object is returned by a function without captures so it can be evaluated twice, once for the size and once for
+   the bytes, and it can be anything but the streamables (virtual), the pointers, the attributes, the paths and the
+   UTF16 strings. The objects of known size must not have padding (std::bit_cast).
+*/
+template <typename SizeType, std::endian vEndian> class BasicConstantWriter
+{
+  public:
+    template <typename Function> [[nodiscard]] static consteval auto Serialize(Function) noexcept
+    {
+        constexpr auto size = [] {
+            Counter counter{};
+            Write(counter, Function{}());
+            return counter.size;
+        }();
+
+        std::array<uint8_t, size> bytes{};
+        Writer writer{bytes.data()};
+        Write(writer, Function{}());
+
+        return bytes;
+    }
+
+  private:
+    static inline constexpr auto IS_ENDIAN_NATIVE = vEndian == std::endian::native;
+
+    struct Counter
+    {
+        Size::size_max size{};
+
+        constexpr void Write(const uint8_t *, const Size::size_max aSize) noexcept
+        {
+            size += aSize;
+        }
+    };
+
+    struct Writer
+    {
+        uint8_t *data{};
+
+        constexpr void Write(const uint8_t *aBytes, const Size::size_max aSize) noexcept
+        {
+            data = std::copy_n(aBytes, aSize, data);
+        }
+    };
+
+    template <typename Sink> static constexpr void WriteCount(Sink &aSink, const Size::size_max aCount) noexcept
+    {
+        const auto size = SizeType::MakeSize(aCount);
+        aSink.Write(size.data.data(), size.count);
+    }
+
+    template <typename Sink, typename Type>
+    static constexpr void WriteObjectOfKnownSize(Sink &aSink, const Type &aObject) noexcept
+    {
+        if constexpr (is_array_v<Type>)
+        {
+            // the arrays are written as the elements of the innermost one
+            for (const auto &object : aObject)
+            {
+                WriteObjectOfKnownSize(aSink, object);
+            }
+        }
+        else
+        {
+            static_assert(std::is_trivially_copyable_v<Type>, "Type can't be copied at compile time!");
+
+            auto object = aObject;
+            if constexpr (!IS_ENDIAN_NATIVE && is_byte_swappable<Type>)
+            {
+                object = ByteSwapper::Swap(object);
+            }
+
+            const auto bytes = std::bit_cast<std::array<uint8_t, sizeof(Type)>>(object);
+            aSink.Write(bytes.data(), bytes.size());
+        }
+    }
+
+    template <typename Sink, typename Type> static constexpr void WriteRange(Sink &aSink, const Type &aRange) noexcept
+    {
+        static_assert(!is_utf16string<Type> && !is_path<Type>, "Type can't be converted at compile time!");
+
+        WriteCount(aSink, SizeFinder::GetRangeCount(aRange));
+
+        for (const auto &object : aRange)
+        {
+            if constexpr (SizeFinder::FindRangeRank<Type>() > 1 && !is_range_of_arrays_of_known_size<Type>)
+            {
+                WriteRange(aSink, object);
+            }
+            else if constexpr (is_range_standard_layout<Type>)
+            {
+                WriteObjectOfKnownSize(aSink, object);
+            }
+            else
+            {
+                Write(aSink, object);
+            }
+        }
+    }
+
+    template <typename Sink, typename Type> static constexpr void Write(Sink &aSink, const Type &aObject) noexcept
+    {
+        if constexpr (is_optional_v<Type>)
+        {
+            WriteCount(aSink, aObject.has_value());
+            if (aObject.has_value())
+            {
+                Write(aSink, *aObject);
+            }
+        }
+        else if constexpr (is_variant_v<Type>)
+        {
+            WriteCount(aSink, aObject.index());
+            std::visit([&](const auto &aArg) { Write(aSink, aArg); }, aObject);
+        }
+        else if constexpr (is_tuple_v<Type>)
+        {
+            std::apply([&](const auto &...aArgs) { (Write(aSink, aArgs), ...); }, aObject);
+        }
+        else if constexpr (is_pair_v<Type>)
+        {
+            Write(aSink, aObject.first);
+            Write(aSink, aObject.second);
+        }
+        else if constexpr (std::ranges::range<Type>)
+        {
+            WriteRange(aSink, aObject);
+        }
+        else if constexpr (is_reflectable_aggregate<Type>)
+        {
+            Reflector::Apply(aObject, [&](const auto &...aFields) { (Write(aSink, aFields), ...); });
+        }
+        else if constexpr (is_object_of_known_size<Type>)
+        {
+            WriteObjectOfKnownSize(aSink, aObject);
+        }
+        else
+        {
+            static_assert(always_false<Type>, "Type can't be serialized at compile time!");
+        }
+    }
+};
+} // namespace hbann
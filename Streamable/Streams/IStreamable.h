@@ -6,6 +6,17 @@
 
 #pragma once
 
+#include "Attributes/Columnar.h"
+#include "Attributes/Dictionary.h"
+#include "Attributes/FileRegion.h"
+#include "Attributes/FrontCoded.h"
+#include "Attributes/HalfFloat.h"
+#include "Attributes/Quantized.h"
+#include "Attributes/StringBlob.h"
+#include "Attributes/XorCompressed.h"
+#include "ConstantWriter.h"
+#include "Serialization.h"
+#include "StaticStreamable.h"
 #include "StreamReader.h"
 #include "StreamWriter.h"
 
@@ -13,8 +24,8 @@ namespace hbann
 {
 class IStreamable
 {
-    friend class StreamWriter;
-    friend class StreamReader;
+    template <typename, std::endian> friend class BasicStreamWriter;
+    template <typename, std::endian> friend class BasicStreamReader;
 
     Stream mStream;
 
@@ -26,14 +37,37 @@ class IStreamable
         return Release();
     }
 
-    constexpr decltype(auto) Serialize(const std::filesystem::path &aFile)
+    // the durable serialization replaces the file atomically only after all of it is synced so a crash can't corrupt it
+    decltype(auto) Serialize(const std::filesystem::path &aFile, const bool aDurable = false)
     {
-        Swap(Stream(aFile, StreamUsageType::SERIALIZE));
+        Swap(Stream(aFile, StreamUsageType::SERIALIZE, false, aDurable));
         ToStream();
         mStream.Clear();
         return Release();
     }
 
+    // serializes without allocations into the buffer (see max_serialized_size), the nested streamables are serialized
+    // into it too, returns the size in bytes of the serialized data or nothing when it didn't fit
+    constexpr std::optional<Size::size_max> Serialize(const std::span<uint8_t> aBuffer)
+    {
+        Swap(Stream(aBuffer));
+        ToStream();
+
+        const auto size = mStream.HasFailed() ? std::nullopt : std::optional(mStream.View().size());
+        mStream.Clear();
+
+        return size;
+    }
+
+    // serializes into spans where the big ranges are referenced in place (see StreamGather), the streamable must not
+    // change until the spans are used
+    [[nodiscard]] decltype(auto) SerializeGather(const Size::size_max aThreshold = StreamGather::THRESHOLD)
+    {
+        Swap(Stream(StreamGather(aThreshold)));
+        ToStream();
+        return Release();
+    }
+
     constexpr void Deserialize(Stream &&aStream, const bool aClear = true)
     {
         Swap(std::move(aStream));
@@ -0,0 +1,186 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "IndexedWriter.h"
+#include "Utilities/FileMapping.h"
+
+namespace hbann
+{
+/*
+    Reads any record of a file written by the BasicIndexedWriter without reading the ones before it, ex.:
+        ::hbann::IndexedReader indexedReader(path);
+        indexedReader.ReadAt(42, event);
+        if (const auto index = indexedReader.Find(user.id))
+        {
+            indexedReader.ReadAt(*index, userID, user);
+        }
+
+    The file is mapped in memory so only the pages of the index and of the records that are used are read. A key that
+   is not in the file is found by the bloom filter most of the times without searching the keys.
+
+    The index is checked before it is used so a file that is not an indexed one or is corrupted has no records and the
+   positions outside of the file are not read.
+*/
+template <typename SizeType, std::endian vEndian> class BasicIndexedReader
+{
+    using writer = BasicIndexedWriter<SizeType, vEndian>;
+    using span = std::span<const uint8_t>;
+
+  public:
+    explicit BasicIndexedReader(const std::filesystem::path &aFile) : mFileMapping(aFile)
+    {
+        const auto bytes = mFileMapping.View();
+        if (bytes.size() < sizeof(typename writer::footer))
+        {
+            return;
+        }
+
+        const auto footer = bytes.last(sizeof(typename writer::footer));
+        const typename writer::footer footerRead{ReadNumber(footer, 0), ReadNumber(footer, 1), ReadNumber(footer, 2),
+                                                 ReadNumber(footer, 3)};
+
+        // the counts are checked against the size of the file before they are multiplied so they can't overflow
+        const auto sizeIndex = bytes.size() - footer.size();
+        if (footerRead.magic != writer::MAGIC || footerRead.indexOffset > sizeIndex ||
+            footerRead.count > sizeIndex / 8 || footerRead.keyCount > sizeIndex / 16)
+        {
+            return;
+        }
+
+        const auto sizeOffsets = footerRead.count * 8;
+        const auto sizeKeys = footerRead.keyCount * 16;
+        const auto sizeFilter = BloomFilter::GetWordCount(footerRead.keyCount) * 8;
+        if (sizeIndex - footerRead.indexOffset != sizeOffsets + sizeKeys + sizeFilter)
+        {
+            return;
+        }
+
+        mRecords = bytes.first(footerRead.indexOffset);
+        mOffsets = bytes.subspan(footerRead.indexOffset, sizeOffsets);
+        mKeys = bytes.subspan(footerRead.indexOffset + sizeOffsets, sizeKeys);
+        mFilter = bytes.subspan(footerRead.indexOffset + sizeOffsets + sizeKeys, sizeFilter);
+    }
+
+    [[nodiscard]] Size::size_max Count() const noexcept
+    {
+        return mOffsets.size() / 8;
+    }
+
+    // reads the objects of the record at the position (a keyed record starts with its key), returns false when there
+    // is no record at the position
+    template <typename... Types> bool ReadAt(const Size::size_max aIndex, Types &...aObjects)
+    {
+        const auto record = GetRecord(aIndex);
+        if (!record)
+        {
+            return false;
+        }
+
+        Stream stream(*record);
+        BasicStreamReader<SizeType, vEndian>(stream).ReadAll(aObjects...);
+
+        return true;
+    }
+
+    // finds the position of a record appended with the key
+    template <typename Key> [[nodiscard]] std::optional<Size::size_max> Find(const Key &aKey)
+    {
+        const auto keyBytes = Serialize<SizeType, vEndian>(aKey);
+        const auto hash = BloomFilter::Hash(keyBytes);
+
+        if (!BloomFilter::MayContain([&](const size_t aWord) { return ReadNumber(mFilter, aWord); },
+                                     mFilter.size() / 8, hash))
+        {
+            return {};
+        }
+
+        const auto keyCount = mKeys.size() / 16;
+        for (auto key = FindKey(hash, keyCount); key < keyCount && ReadNumber(mKeys, key * 2) == hash; key++)
+        {
+            // the key is serialized the same way at the start of the record
+            const auto index = ReadNumber(mKeys, key * 2 + 1);
+            const auto record = GetRecord(index);
+            if (record && record->size() >= keyBytes.size() &&
+                !std::memcmp(record->data(), keyBytes.data(), keyBytes.size()))
+            {
+                return index;
+            }
+        }
+
+        return {};
+    }
+
+  private:
+    FileMapping mFileMapping;
+
+    span mRecords{};
+    span mOffsets{};
+    span mKeys{};
+    span mFilter{};
+
+    [[nodiscard]] static uint64_t ReadNumber(const span aNumbers, const Size::size_max aIndex) noexcept
+    {
+        uint64_t number{};
+        std::memcpy(&number, aNumbers.data() + aIndex * sizeof(number), sizeof(number));
+
+        if constexpr (vEndian != std::endian::native)
+        {
+            number = ByteSwapper::Swap(number);
+        }
+
+        return number;
+    }
+
+    // the first key with the hash
+    [[nodiscard]] Size::size_max FindKey(const uint64_t aHash, const Size::size_max aKeyCount) const noexcept
+    {
+        Size::size_max first{}, count = aKeyCount;
+        while (count)
+        {
+            const auto step = count / 2;
+            if (ReadNumber(mKeys, (first + step) * 2) < aHash)
+            {
+                first += step + 1;
+                count -= step + 1;
+            }
+            else
+            {
+                count = step;
+            }
+        }
+
+        return first;
+    }
+
+    // the objects of the record without its size, nothing when the position or the record is outside of the records
+    [[nodiscard]] std::optional<span> GetRecord(const Size::size_max aIndex)
+    {
+        if (aIndex >= Count())
+        {
+            return {};
+        }
+
+        const auto offset = ReadNumber(mOffsets, aIndex);
+        if (offset >= mRecords.size())
+        {
+            return {};
+        }
+
+        Stream stream(mRecords.subspan(offset));
+        const auto size = BasicStreamReader<SizeType, vEndian>(stream).ReadCount();
+
+        const auto record = stream.Read(size);
+        if (record.size() != size)
+        {
+            return {};
+        }
+
+        return record;
+    }
+};
+} // namespace hbann
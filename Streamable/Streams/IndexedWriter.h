@@ -0,0 +1,146 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "Serialization.h"
+#include "Utilities/BloomFilter.h"
+
+namespace hbann
+{
+/*
+    Writes records like the BasicRecordWriter followed by an index so any record can be read directly by its position or
+   by its key (see BasicIndexedReader), ex.:
+        ::hbann::IndexedWriter indexedWriter(path);
+        indexedWriter.Append(event);
+        indexedWriter.AppendKeyed(user.id, user);
+        indexedWriter.Close();
+
+    The key of a record is serialized before its objects and the record is found by the hash of the serialized key.
+
+    The file is written durably (see StreamFile) and replaces the old one only when the writer is closed explicitly so
+   a writer abandoned (ex.: by an exception) leaves no file with a valid index over partial records.
+
+    The index is written at the end of the file when the writer is closed:
+        - the offsets of the records
+        - the hashes of the keys with the positions of their records sorted by the hash
+        - a bloom filter of the hashes so most of the keys that are not in the file are not searched
+        - the footer
+    The numbers of the index are written as 8 bytes with the endianness of the writer.
+*/
+template <typename SizeType, std::endian vEndian> class BasicIndexedWriter
+{
+  public:
+    static inline constexpr uint64_t MAGIC = 0x5844'4E49'4D52'5453; // "STRMINDX"
+
+    struct footer
+    {
+        uint64_t count{};
+        uint64_t indexOffset{};
+        uint64_t keyCount{};
+        uint64_t magic{};
+    };
+
+    struct entry
+    {
+        uint64_t hash{};
+        uint64_t index{};
+
+        constexpr auto operator<=>(const entry &) const noexcept = default;
+    };
+
+    explicit BasicIndexedWriter(const std::filesystem::path &aFile)
+        : mStream(aFile, StreamUsageType::SERIALIZE, false, true)
+    {
+    }
+
+    // returns the position of the record
+    template <typename... Types> Size::size_max Append(const Types &...aObjects)
+    {
+        WriteRecord(Serialize<SizeType, vEndian>(aObjects...));
+        return mOffsets.size() - 1;
+    }
+
+    // returns the position of the record
+    template <typename Key, typename... Types> Size::size_max AppendKeyed(const Key &aKey, const Types &...aObjects)
+    {
+        mKeys.push_back({BloomFilter::Hash(Serialize<SizeType, vEndian>(aKey)), mOffsets.size()});
+        return Append(aKey, aObjects...);
+    }
+
+    // writes the index after the records and replaces the file with the new one
+    void Close()
+    {
+        if (mClosed)
+        {
+            return;
+        }
+
+        const auto indexOffset = mOffset;
+        for (const auto offset : mOffsets)
+        {
+            WriteNumber(offset);
+        }
+
+        std::ranges::sort(mKeys);
+        for (const auto &key : mKeys)
+        {
+            WriteNumber(key.hash);
+            WriteNumber(key.index);
+        }
+
+        std::vector<uint64_t> words(BloomFilter::GetWordCount(mKeys.size()));
+        for (const auto &key : mKeys)
+        {
+            BloomFilter::Add(words, key.hash);
+        }
+
+        for (const auto word : words)
+        {
+            WriteNumber(word);
+        }
+
+        WriteNumber(mOffsets.size());
+        WriteNumber(indexOffset);
+        WriteNumber(mKeys.size());
+        WriteNumber(MAGIC);
+
+        mStream.Clear();
+        mOffsets = {};
+        mKeys = {};
+        mClosed = true;
+    }
+
+  private:
+    Stream mStream;
+    Size::size_max mOffset{};
+    bool mClosed{};
+
+    std::vector<uint64_t> mOffsets{};
+    std::vector<entry> mKeys{};
+
+    void WriteRecord(const std::span<const uint8_t> aRecord)
+    {
+        mOffsets.push_back(mOffset);
+
+        const auto size = SizeType::MakeSize(aRecord.size());
+        mStream.Write(size).Write(aRecord);
+
+        mOffset += size.count + aRecord.size();
+    }
+
+    void WriteNumber(uint64_t aNumber)
+    {
+        if constexpr (vEndian != std::endian::native)
+        {
+            aNumber = ByteSwapper::Swap(aNumber);
+        }
+
+        mStream.Write({reinterpret_cast<const uint8_t *>(&aNumber), sizeof(aNumber)});
+        mOffset += sizeof(aNumber);
+    }
+};
+} // namespace hbann
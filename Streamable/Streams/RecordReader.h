@@ -0,0 +1,141 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "StreamReader.h"
+
+namespace hbann
+{
+/*
+    Reads the records of a log one at a time (see BasicRecordWriter), ex.:
+        ::hbann::RecordReader recordReader(path);
+        for (const auto &event : recordReader.Records<Event>())
+        {
+            ...
+        }
+
+    A record torn by a crash while it was appended ends the log like the end of the file.
+*/
+template <typename SizeType, std::endian vEndian> class BasicRecordReader
+{
+  public:
+    // a single pass iterator that deserializes a record when it is incremented
+    template <typename Type> class iterator
+    {
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = Type;
+
+        iterator() noexcept = default;
+
+        explicit iterator(BasicRecordReader &aRecordReader) : mRecordReader(&aRecordReader)
+        {
+            ++*this;
+        }
+
+        [[nodiscard]] const Type &operator*() const noexcept
+        {
+            return mRecord;
+        }
+
+        [[nodiscard]] const Type *operator->() const noexcept
+        {
+            return &mRecord;
+        }
+
+        iterator &operator++()
+        {
+            mRecord = {};
+            if (!mRecordReader->Next(mRecord))
+            {
+                mRecordReader = nullptr;
+            }
+
+            return *this;
+        }
+
+        void operator++(int)
+        {
+            ++*this;
+        }
+
+        [[nodiscard]] bool operator==(std::default_sentinel_t) const noexcept
+        {
+            return !mRecordReader;
+        }
+
+      private:
+        BasicRecordReader *mRecordReader{};
+        Type mRecord{};
+    };
+
+    explicit BasicRecordReader(const std::filesystem::path &aFile) : mStream(aFile, StreamUsageType::DESERIALIZE)
+    {
+    }
+
+    // the records of a log that is already in memory (mapped, received etc...)
+    explicit BasicRecordReader(const std::span<const uint8_t> aBytes) noexcept : mStream(aBytes)
+    {
+    }
+
+    // reads the next record into the objects, false when there are no more records
+    template <typename... Types> bool Next(Types &...aObjects)
+    {
+        const auto record = NextRecord();
+        if (!record)
+        {
+            return false;
+        }
+
+        Stream stream(*record);
+        BasicStreamReader<SizeType, vEndian>(stream).ReadAll(aObjects...);
+
+        return true;
+    }
+
+    // moves over the next record without deserializing it, false when there are no more records
+    bool Skip()
+    {
+        return NextRecord().has_value();
+    }
+
+    template <typename Type> [[nodiscard]] std::ranges::subrange<iterator<Type>, std::default_sentinel_t> Records()
+    {
+        return {iterator<Type>(*this), std::default_sentinel};
+    }
+
+    // the count of the bytes of the whole records read until now, the torn record starts after them
+    [[nodiscard]] Size::size_max GetSize() const noexcept
+    {
+        return mSize;
+    }
+
+  private:
+    Stream mStream;
+    Size::size_max mSize{};
+
+    // the bytes of the record are valid until the next read from the stream
+    std::optional<std::span<const uint8_t>> NextRecord()
+    {
+        if (mStream.IsEOS())
+        {
+            return {};
+        }
+
+        const auto size = BasicStreamReader<SizeType, vEndian>(mStream).ReadCount();
+        const auto record = mStream.Read(size);
+        if (record.size() != size)
+        {
+            return {};
+        }
+
+        mSize += SizeType::FindRequiredBytes(size) + size;
+        return record;
+    }
+};
+} // namespace hbann
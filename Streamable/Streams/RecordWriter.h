@@ -0,0 +1,157 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "RecordReader.h"
+#include "Serialization.h"
+
+namespace hbann
+{
+/*
+    Appends records to a log file, every record is the size in bytes of its objects followed by the objects written
+   like by StreamWriter::WriteAll, ex.:
+        ::hbann::RecordWriter recordWriter(path);
+        recordWriter.Append(event);
+        recordWriter.Append(id, name);
+
+    The records are written through the buffers of the file and are all in the file when the record writer is closed
+   (see BasicRecordReader for reading them). The record torn by a crash at the end of the log is cut off before
+   appending so the records after it can be read, the log is read once for it.
+
+    The records are durable after they are committed. Many threads can append and commit at once and the ones that
+   commit while the file is synced are synced together by the next sync (group commit), ex.:
+        recordWriter.Append(event);
+        recordWriter.Commit();
+*/
+template <typename SizeType, std::endian vEndian> class BasicRecordWriter
+{
+  public:
+    // the records are appended after the last whole one unless the file is truncated
+    explicit BasicRecordWriter(const std::filesystem::path &aFile, const bool aAppend = true)
+    {
+        if (aAppend)
+        {
+            CutTorn(aFile);
+        }
+
+        mStream = Stream(aFile, StreamUsageType::SERIALIZE, aAppend);
+    }
+
+    template <typename... Types> BasicRecordWriter &Append(const Types &...aObjects)
+    {
+        std::lock_guard lock(mMutex);
+
+        if constexpr ((SizeFinder::FindSerializedSize<Types, SizeType>().bounded && ...))
+        {
+            // the records of bounded size are serialized into the same memory without allocations
+            constexpr auto sizeMax = (Size::size_max{} + ... + SizeFinder::FindSerializedSize<Types, SizeType>().max);
+            mRecord.resize(std::max<size_t>(mRecord.size(), sizeMax));
+
+            const auto size = SerializeInto<SizeType, vEndian>(mRecord, aObjects...);
+            WriteRecord({mRecord.data(), *size});
+        }
+        else
+        {
+            WriteRecord(Serialize<SizeType, vEndian>(aObjects...));
+        }
+
+        mCount++;
+        return *this;
+    }
+
+    // makes the records appended until now durable, returns false when the file couldn't be synced
+    bool Commit()
+    {
+        std::unique_lock lock(mMutex);
+
+        const auto count = mCount;
+        while (mCountCommitted < count)
+        {
+            if (mCommitting)
+            {
+                mCommitted.wait(lock);
+                continue;
+            }
+
+            // the leader syncs the records of everyone waiting and the others can still append while it syncs
+            mCommitting = true;
+            mStream.Flush();
+            const auto countCommit = mCount;
+
+            lock.unlock();
+            const auto synced = mStream.Sync();
+            lock.lock();
+
+            mCommitting = false;
+            if (synced)
+            {
+                mCountCommitted = countCommit;
+            }
+
+            mCommitted.notify_all();
+            if (!synced)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // writes the buffered records and closes the file
+    void Close()
+    {
+        std::unique_lock lock(mMutex);
+        mCommitted.wait(lock, [&] { return !mCommitting; });
+
+        mStream.Clear();
+    }
+
+  private:
+    Stream mStream;
+    std::vector<uint8_t> mRecord{};
+
+    // the records are counted so a commit knows if its records were synced by another one
+    std::mutex mMutex{};
+    std::condition_variable mCommitted{};
+    Size::size_max mCount{};
+    Size::size_max mCountCommitted{};
+    bool mCommitting{};
+
+    // the records read from the log end where a record is torn so the file is cut after the last whole one
+    static void CutTorn(const std::filesystem::path &aFile)
+    {
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(aFile, ec);
+        if (ec)
+        {
+            return;
+        }
+
+        Size::size_max sizeWhole{};
+        {
+            BasicRecordReader<SizeType, vEndian> recordReader(aFile);
+            while (recordReader.Skip())
+            {
+            }
+
+            sizeWhole = recordReader.GetSize();
+        }
+
+        if (sizeWhole < size)
+        {
+            std::filesystem::resize_file(aFile, sizeWhole, ec);
+        }
+    }
+
+    void WriteRecord(const std::span<const uint8_t> aRecord)
+    {
+        BasicStreamWriter<SizeType, vEndian>(mStream).WriteCount(aRecord.size());
+        mStream.Write(aRecord);
+    }
+};
+} // namespace hbann
@@ -0,0 +1,108 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "StreamReader.h"
+#include "StreamWriter.h"
+
+namespace hbann
+{
+/*
+    (De)serializes any objects accepted by the StreamWriter/StreamReader without a streamable wrapping them, ex.:
+        const auto bytes = ::hbann::Serialize(cache);
+        const auto cacheRead = ::hbann::Deserialize<decltype(cache)>(bytes);
+
+    The objects are written one after another like by StreamWriter::WriteAll. They are not modified, the constness is
+   removed only so they can go through the StreamWriter (the streamables use their own stream while serializing).
+*/
+
+// serializes the objects into a new vector, its capacity is reserved up front when the objects have a bounded size
+template <typename SizeType = STREAMABLE_SIZE_TYPE, std::endian vEndian = STREAMABLE_ENDIAN, typename... Types>
+[[nodiscard]] constexpr std::vector<uint8_t> Serialize(const Types &...aObjects)
+{
+    Stream stream;
+
+    if constexpr ((SizeFinder::FindSerializedSize<Types, SizeType>().bounded && ...))
+    {
+        stream.Reserve((Size::size_max{} + ... + SizeFinder::FindSerializedSize<Types, SizeType>().max));
+    }
+
+    BasicStreamWriter<SizeType, vEndian>(stream).WriteAll(const_cast<Types &>(aObjects)...);
+    return stream.Release();
+}
+
+// serializes the objects without allocations into the buffer (see max_serialized_size), returns the size in bytes of
+// the serialized data or nothing when it didn't fit
+template <typename SizeType = STREAMABLE_SIZE_TYPE, std::endian vEndian = STREAMABLE_ENDIAN, typename... Types>
+constexpr std::optional<Size::size_max> SerializeInto(const std::span<uint8_t> aBuffer, const Types &...aObjects)
+{
+    Stream stream(aBuffer);
+    BasicStreamWriter<SizeType, vEndian>(stream).WriteAll(const_cast<Types &>(aObjects)...);
+
+    return stream.HasFailed() ? std::nullopt : std::optional(stream.View().size());
+}
+
+// serializes the objects followed by the CRC32C of their bytes computed while they are written (see
+// Stream::WriteChecksum)
+template <typename SizeType = STREAMABLE_SIZE_TYPE, std::endian vEndian = STREAMABLE_ENDIAN, typename... Types>
+[[nodiscard]] std::vector<uint8_t> SerializeChecked(const Types &...aObjects)
+{
+    Stream stream;
+    stream.BeginChecksum();
+
+    BasicStreamWriter<SizeType, vEndian>(stream).WriteAll(const_cast<Types &>(aObjects)...);
+    return stream.WriteChecksum().Release();
+}
+
+// deserializes the objects serialized by SerializeChecked verifying the bytes while they are read, returns false when
+// they are corrupted or truncated (the objects can be read partially)
+template <typename SizeType = STREAMABLE_SIZE_TYPE, std::endian vEndian = STREAMABLE_ENDIAN, typename... Types>
+[[nodiscard]] bool DeserializeIntoChecked(const std::span<const uint8_t> aBytes, Types &...aObjects)
+{
+    Stream stream(aBytes);
+    stream.BeginChecksum();
+
+    BasicStreamReader<SizeType, vEndian>(stream).ReadAll(aObjects...);
+    return stream.ReadChecksum() && stream.IsEOS();
+}
+
+// serializes the objects compressed in chunks while they are written (see StreamCompressed)
+template <typename SizeType = STREAMABLE_SIZE_TYPE, std::endian vEndian = STREAMABLE_ENDIAN, typename... Types>
+[[nodiscard]] std::vector<uint8_t> SerializeCompressed(const CompressionType aCompressionType,
+                                                       const Types &...aObjects)
+{
+    Stream stream(StreamCompressed(Stream(), aCompressionType));
+    BasicStreamWriter<SizeType, vEndian>(stream).WriteAll(const_cast<Types &>(aObjects)...);
+
+    return stream.Release();
+}
+
+// deserializes the objects serialized by SerializeCompressed decompressing the chunks while they are read
+template <typename SizeType = STREAMABLE_SIZE_TYPE, std::endian vEndian = STREAMABLE_ENDIAN, typename... Types>
+void DeserializeIntoCompressed(const std::span<const uint8_t> aBytes, Types &...aObjects)
+{
+    Stream stream(StreamCompressed(static_cast<Stream>(aBytes)));
+    BasicStreamReader<SizeType, vEndian>(stream).ReadAll(aObjects...);
+}
+
+// deserializes the objects in the order they were serialized reusing their memory
+template <typename SizeType = STREAMABLE_SIZE_TYPE, std::endian vEndian = STREAMABLE_ENDIAN, typename... Types>
+constexpr void DeserializeInto(const std::span<const uint8_t> aBytes, Types &...aObjects)
+{
+    Stream stream(aBytes);
+    BasicStreamReader<SizeType, vEndian>(stream).ReadAll(aObjects...);
+}
+
+template <typename Type, typename SizeType = STREAMABLE_SIZE_TYPE, std::endian vEndian = STREAMABLE_ENDIAN>
+[[nodiscard]] constexpr Type Deserialize(const std::span<const uint8_t> aBytes)
+{
+    Type object{};
+    DeserializeInto<SizeType, vEndian>(aBytes, object);
+
+    return object;
+}
+} // namespace hbann
@@ -0,0 +1,72 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "StreamReader.h"
+#include "StreamWriter.h"
+
+namespace hbann
+{
+/*
+    The base of the non polymorphic streamables, they are (de)serialized without virtual calls so the whole object graph
+   is resolved at compile time and can be inlined, ex.:
+        class Point : public ::hbann::StaticStreamable
+        {
+            STREAMABLE_DEFINE_STATIC(Point, mX, mY)
+            ...
+        };
+
+    The bases are passed to STREAMABLE_DEFINE_STATIC_BASE and the format is the same as the one of the IStreamable with
+   the same fields and bases so a class can switch between them.
+*/
+class StaticStreamable
+{
+  protected:
+    constexpr StaticStreamable() noexcept = default;
+
+    template <typename Type> [[nodiscard]] static constexpr Stream SerializeStreamable(Type &aStreamable)
+    {
+        Stream stream;
+        StreamWriter(stream).WriteStaticStreamableFields(aStreamable);
+
+        return stream;
+    }
+
+    template <typename Type>
+    static Stream SerializeStreamable(Type &aStreamable, const std::filesystem::path &aFile)
+    {
+        Stream stream(aFile, StreamUsageType::SERIALIZE);
+        StreamWriter(stream).WriteStaticStreamableFields(aStreamable);
+        stream.Clear();
+
+        return stream;
+    }
+
+    template <typename Type>
+    static constexpr Size::size_max SerializeStreamable(Type &aStreamable, const std::span<uint8_t> aBuffer)
+    {
+        Stream stream(aBuffer);
+        StreamWriter(stream).WriteStaticStreamableFields(aStreamable);
+
+        return stream.View().size();
+    }
+
+    template <typename Type> static constexpr void DeserializeStreamable(Type &aStreamable, Stream &&aStream)
+    {
+        auto stream(std::move(aStream));
+        StreamReader(stream).ReadStaticStreamableFields(aStreamable);
+    }
+
+    template <typename Type>
+    static void DeserializeStreamable(Type &aStreamable, const std::filesystem::path &aFile, const bool aRemoveFile)
+    {
+        Stream stream(aFile, StreamUsageType::DESERIALIZE);
+        StreamReader(stream).ReadStaticStreamableFields(aStreamable);
+        stream.Clear(aRemoveFile);
+    }
+};
+} // namespace hbann
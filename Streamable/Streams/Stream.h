@@ -6,27 +6,53 @@
 
 #pragma once
 
+#include "StreamCompressed.h"
+#include "StreamDescriptor.h"
 #include "StreamFile.h"
+#include "StreamGather.h"
+#include "Utilities/ByteSwapper.h"
+#include "Utilities/Crc32c.h"
 
 namespace hbann
 {
-// Represents a vector/file when used for serialization
-// and a span/file when used for deserialization
+// Represents a vector/buffer/file/descriptor/gather/compressed stream when used for serialization
+// and a span/file/descriptor/compressed stream when used for deserialization
 class Stream
 {
-    friend class StreamReader;
+    template <typename, std::endian> friend class BasicStreamReader;
+    template <typename, std::endian> friend class BasicStreamWriter;
+    template <typename> friend class BasicStreamCompressed;
+    friend class Attribute;
 
     using vector = std::vector<uint8_t>;
     using span = std::span<const uint8_t>;
-    using stream = std::variant<vector, span, StreamFile>;
+
+    // a fixed memory serialized into without allocations, a write that doesn't fit marks it as overflowed and nothing
+    // is written after it (see HasFailed)
+    struct buffer
+    {
+        std::span<uint8_t> data{};
+        Size::size_max size{};
+        bool overflowed{};
+    };
+
+    using stream = std::variant<vector, span, StreamFile, buffer, StreamDescriptor, StreamGather, StreamCompressed>;
 
   public:
     constexpr explicit Stream() noexcept : mStreamUsageType(StreamUsageType::SERIALIZE), mStream(vector())
     {
     }
 
-    explicit Stream(const std::filesystem::path &aFile, const StreamUsageType aType)
-        : mStreamUsageType(aType), mStream(StreamFile(aFile, aType))
+    // the durable serialization replaces the file only after all of it is synced (see StreamFile)
+    explicit Stream(const std::filesystem::path &aFile, const StreamUsageType aType, const bool aAppend = false,
+                    const bool aDurable = false)
+        : mStreamUsageType(aType), mStream(StreamFile(aFile, aType, aAppend, aDurable))
+    {
+    }
+
+    // a pipe, a socket, stdin/stdout etc... that is closed with the stream only when it is owned
+    explicit Stream(const File::handle aHandle, const StreamUsageType aType, const bool aOwn = false)
+        : mStreamUsageType(aType), mStream(StreamDescriptor(aHandle, aType, aOwn))
     {
     }
 
@@ -35,6 +61,22 @@ class Stream
     {
     }
 
+    constexpr explicit Stream(const std::span<uint8_t> aBuffer) noexcept
+        : mStreamUsageType(StreamUsageType::SERIALIZE), mStream(buffer{aBuffer})
+    {
+    }
+
+    explicit Stream(StreamGather &&aStreamGather) noexcept
+        : mStreamUsageType(StreamUsageType::SERIALIZE), mStream(std::move(aStreamGather))
+    {
+    }
+
+    // the bytes written/read are (de)compressed in chunks (see StreamCompressed)
+    explicit Stream(StreamCompressed &&aStreamCompressed) noexcept
+        : mStreamUsageType(aStreamCompressed.mStreamUsageType), mStream(std::move(aStreamCompressed))
+    {
+    }
+
     constexpr Stream(Stream &&aStream) noexcept
     {
         *this = std::move(aStream);
@@ -42,11 +84,23 @@ class Stream
 
     constexpr vector &&Release() noexcept
     {
-        assert(!IsView());
+        assert(!IsView() && !IsBuffer());
         if (IsStreamFile())
         {
             return (std::move)(GetStreamFile().Release());
         }
+        else if (IsStreamDescriptor())
+        {
+            return (std::move)(GetStreamDescriptor().Release());
+        }
+        else if (IsStreamGather())
+        {
+            return (std::move)(GetStreamGather().Release());
+        }
+        else if (IsStreamCompressed())
+        {
+            return (std::move)(GetStreamCompressed().Release());
+        }
         else
         {
             return (std::move)(GetStream());
@@ -56,10 +110,21 @@ class Stream
     template <typename FunctionSeek>
     constexpr decltype(auto) Peek(FunctionSeek &&aFunctionSeek, const Size::size_max aOffset = 0)
     {
+        // the bytes peeked are read again so they are not checksummed now
+        const auto checksum = std::exchange(mChecksum, {});
+
         if (IsStreamFile())
         {
             GetStreamFile().Peek(std::move(aFunctionSeek), aOffset);
         }
+        else if (IsStreamDescriptor())
+        {
+            GetStreamDescriptor().Peek(std::move(aFunctionSeek), aOffset);
+        }
+        else if (IsStreamCompressed())
+        {
+            GetStreamCompressed().Peek(std::move(aFunctionSeek), aOffset);
+        }
         else
         {
             const auto readIndex = mReadIndex;
@@ -68,6 +133,7 @@ class Stream
             mReadIndex = readIndex;
         }
 
+        mChecksum = checksum;
         return *this;
     }
 
@@ -80,6 +146,22 @@ class Stream
         {
             GetStreamFile().Reserve(aSize);
         }
+        else if (IsStreamDescriptor())
+        {
+            GetStreamDescriptor().Reserve(aSize);
+        }
+        else if (IsStreamGather())
+        {
+            GetStreamGather().Reserve(aSize);
+        }
+        else if (IsStreamCompressed())
+        {
+            GetStreamCompressed().Reserve(aSize);
+        }
+        else if (IsBuffer())
+        {
+            // the bytes that don't fit fail the stream when they are written
+        }
         else
         {
             GetStream().reserve(aSize);
@@ -88,17 +170,32 @@ class Stream
         return *this;
     }
 
-    [[nodiscard]] constexpr auto View() noexcept
+    [[nodiscard]] constexpr span View() noexcept
     {
-        assert(!IsStreamFile());
+        assert(!IsStreamFile() && !IsStreamDescriptor() && !IsStreamGather() && !IsStreamCompressed());
+
+        if (IsBuffer())
+        {
+            return {GetBuffer().data.data(), GetBuffer().size};
+        }
+
         return IsView() ? GetSpan() : GetStream();
     }
 
-    [[nodiscard]] constexpr auto Read(Size::size_max aSize) noexcept
+    [[nodiscard]] constexpr span Read(Size::size_max aSize) noexcept
     {
+        span bytes{};
         if (IsStreamFile())
         {
-            return GetStreamFile().Read(aSize);
+            bytes = GetStreamFile().Read(aSize);
+        }
+        else if (IsStreamDescriptor())
+        {
+            bytes = GetStreamDescriptor().Read(aSize);
+        }
+        else if (IsStreamCompressed())
+        {
+            bytes = GetStreamCompressed().Read(aSize);
         }
         else
         {
@@ -111,7 +208,47 @@ class Stream
             }
 
             mReadIndex += aSize;
-            return span{view.data() + (mReadIndex - aSize), aSize};
+            bytes = {view.data() + (mReadIndex - aSize), aSize};
+        }
+
+        UpdateChecksum(bytes);
+        return bytes;
+    }
+
+    // the spans of the serialized data (see StreamGather)
+    [[nodiscard]] const std::vector<span> &Gather() noexcept
+    {
+        return GetStreamGather().Gather();
+    }
+
+    // reads into the bytes, the files read the big ones straight into them, returns the count of the bytes read
+    constexpr Size::size_max ReadInto(const std::span<uint8_t> aBytes)
+    {
+        if (IsStreamFile() || IsStreamDescriptor() || IsStreamCompressed())
+        {
+            Size::size_max size{};
+            if (IsStreamFile())
+            {
+                size = GetStreamFile().ReadInto(aBytes);
+            }
+            else if (IsStreamDescriptor())
+            {
+                size = GetStreamDescriptor().ReadInto(aBytes);
+            }
+            else
+            {
+                size = GetStreamCompressed().ReadInto(aBytes);
+            }
+
+            UpdateChecksum(aBytes.first(size));
+            return size;
+        }
+        else
+        {
+            const auto view = Read(aBytes.size());
+            std::memcpy(aBytes.data(), view.data(), view.size());
+
+            return view.size();
         }
     }
 
@@ -121,6 +258,14 @@ class Stream
         {
             return GetStreamFile().Current();
         }
+        else if (IsStreamDescriptor())
+        {
+            return GetStreamDescriptor().Current();
+        }
+        else if (IsStreamCompressed())
+        {
+            return GetStreamCompressed().Current();
+        }
         else
         {
             return View()[mReadIndex];
@@ -133,6 +278,14 @@ class Stream
         {
             return GetStreamFile().IsEOS();
         }
+        else if (IsStreamDescriptor())
+        {
+            return GetStreamDescriptor().IsEOS();
+        }
+        else if (IsStreamCompressed())
+        {
+            return GetStreamCompressed().IsEOS();
+        }
         else
         {
             return View().size() == mReadIndex;
@@ -144,10 +297,38 @@ class Stream
         assert(!IsView());
         assert(mStreamUsageType == StreamUsageType::SERIALIZE);
 
+        UpdateChecksum(aSpan);
+
         if (IsStreamFile())
         {
             GetStreamFile().Write(aSpan);
         }
+        else if (IsStreamDescriptor())
+        {
+            GetStreamDescriptor().Write(aSpan);
+        }
+        else if (IsStreamGather())
+        {
+            GetStreamGather().Write(aSpan);
+        }
+        else if (IsStreamCompressed())
+        {
+            GetStreamCompressed().Write(aSpan);
+        }
+        else if (IsBuffer())
+        {
+            // the bytes that don't fit fail the stream (see HasFailed) and nothing is written after them, they can be
+            // in the buffer already (see BasicStreamWriter::WriteStreamable)
+            auto &streamBuffer = GetBuffer();
+            if (streamBuffer.overflowed || aSpan.size() > streamBuffer.data.size() - streamBuffer.size)
+            {
+                streamBuffer.overflowed = true;
+                return *this;
+            }
+
+            std::memmove(streamBuffer.data.data() + streamBuffer.size, aSpan.data(), aSpan.size());
+            streamBuffer.size += aSpan.size();
+        }
         else
         {
             GetStream().insert(GetStream().end(), aSpan.data(), aSpan.data() + aSpan.size());
@@ -156,11 +337,199 @@ class Stream
         return *this;
     }
 
+    // writes the bytes of the file region, the files and the descriptors move them in the kernel when they can and the
+    // other streams copy them, returns the count of the bytes written that is smaller when the file ended before it
+    Size::size_max WriteRegion(File &aFile, const Size::size_max aOffset, const Size::size_max aSize)
+    {
+        assert(mStreamUsageType == StreamUsageType::SERIALIZE);
+
+        // the bytes that are checksummed must go through memory
+        if (IsStreamFile() && !mChecksum)
+        {
+            return GetStreamFile().WriteRegion(aFile, aOffset, aSize);
+        }
+        else if (IsStreamDescriptor() && !mChecksum)
+        {
+            return GetStreamDescriptor().WriteRegion(aFile, aOffset, aSize);
+        }
+        else if (IsStream())
+        {
+            auto &bytes = GetStream();
+            const auto size = bytes.size();
+
+            bytes.resize(size + aSize);
+            bytes.resize(size + aFile.ReadAt(std::span(bytes).subspan(size), aOffset));
+            UpdateChecksum(span(bytes).subspan(size));
+
+            return bytes.size() - size;
+        }
+
+        vector bytes(std::min(aSize, StreamFile::BUFFER_SIZE));
+        Size::size_max size{};
+        while (size < aSize)
+        {
+            const auto count =
+                aFile.ReadAt(std::span(bytes).first(std::min(bytes.size(), aSize - size)), aOffset + size);
+            if (!count)
+            {
+                break;
+            }
+
+            Write({bytes.data(), count});
+            size += count;
+        }
+
+        return size;
+    }
+
+    // reads the bytes into the file region, the files and the descriptors move them in the kernel when they can,
+    // returns the count of the bytes read
+    Size::size_max ReadRegion(File &aFile, const Size::size_max aOffset, const Size::size_max aSize)
+    {
+        if (IsStreamFile() && !mChecksum)
+        {
+            return GetStreamFile().ReadRegion(aFile, aOffset, aSize);
+        }
+        else if (IsStreamDescriptor() && !mChecksum)
+        {
+            return GetStreamDescriptor().ReadRegion(aFile, aOffset, aSize);
+        }
+
+        Size::size_max size{};
+        while (size < aSize)
+        {
+            const auto bytes = Read(std::min(aSize - size, StreamFile::BUFFER_SIZE));
+            if (bytes.empty() || aFile.WriteAt(bytes, aOffset + size) != bytes.size())
+            {
+                break;
+            }
+
+            size += bytes.size();
+        }
+
+        return size;
+    }
+
+    // starts the CRC32C of the bytes written/read from now on (see WriteChecksum and ReadChecksum)
+    constexpr Stream &BeginChecksum() noexcept
+    {
+        mChecksum = 0;
+        return *this;
+    }
+
+    // writes the CRC32C of the bytes written since BeginChecksum after them (as 4 bytes little endian)
+    Stream &WriteChecksum()
+    {
+        assert(mChecksum);
+        auto checksum = *std::exchange(mChecksum, {});
+
+        if constexpr (std::endian::native != std::endian::little)
+        {
+            checksum = ByteSwapper::Swap(checksum);
+        }
+
+        return Write({reinterpret_cast<const uint8_t *>(&checksum), sizeof(checksum)});
+    }
+
+    // reads the CRC32C written by WriteChecksum, returns false when the bytes read since BeginChecksum were
+    // corrupted or truncated
+    [[nodiscard]] bool ReadChecksum()
+    {
+        assert(mChecksum);
+        const auto checksum = *std::exchange(mChecksum, {});
+
+        uint32_t checksumRead{};
+        const auto bytes = Read(sizeof(checksumRead));
+        if (bytes.size() != sizeof(checksumRead))
+        {
+            return false;
+        }
+
+        std::memcpy(&checksumRead, bytes.data(), sizeof(checksumRead));
+        if constexpr (std::endian::native != std::endian::little)
+        {
+            checksumRead = ByteSwapper::Swap(checksumRead);
+        }
+
+        return checksum == checksumRead;
+    }
+
+    // writes the bytes buffered by the file or the descriptor into it, the compressed stream writes a chunk of them
+    // (see File::Sync for making them durable)
+    Stream &Flush()
+    {
+        if (IsStreamFile())
+        {
+            GetStreamFile().Drain();
+        }
+        else if (IsStreamDescriptor())
+        {
+            GetStreamDescriptor().Drain();
+        }
+        else if (IsStreamCompressed())
+        {
+            GetStreamCompressed().Flush();
+        }
+
+        return *this;
+    }
+
+    // makes the bytes written into the file or the descriptor durable (see Flush), it can be called while another
+    // thread writes, returns false when it failed, when a write failed before (see HasFailed) or when the stream is in
+    // memory
+    bool Sync() noexcept
+    {
+        if (IsStreamFile())
+        {
+            return GetStreamFile().Sync();
+        }
+        else if (IsStreamDescriptor())
+        {
+            return GetStreamDescriptor().Sync();
+        }
+        else if (IsStreamCompressed())
+        {
+            return GetStreamCompressed().Sync();
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    // true when a transfer of the file came up short (ex.: the disk is full or a read failed), a write of the
+    // descriptor failed (ex.: the pipe was closed) or the bytes written didn't fit in the buffer so the bytes after it
+    // were lost, it stays set after Clear for the files and the descriptors
+    [[nodiscard]] constexpr bool HasFailed() const noexcept
+    {
+        if (IsStreamFile())
+        {
+            return std::get<StreamFile>(mStream).HasFailed();
+        }
+        else if (IsStreamDescriptor())
+        {
+            return std::get<StreamDescriptor>(mStream).HasFailed();
+        }
+        else if (IsStreamCompressed())
+        {
+            return std::get<StreamCompressed>(mStream).HasFailed();
+        }
+        else if (IsBuffer())
+        {
+            return std::get<buffer>(mStream).overflowed;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
     constexpr Stream &operator=(Stream &&aStream) noexcept
     {
         mStreamUsageType = aStream.mStreamUsageType;
         mStream = std::move(aStream.mStream);
         mReadIndex = aStream.mReadIndex;
+        mChecksum = aStream.mChecksum;
 
         return *this;
     }
@@ -175,13 +544,30 @@ class Stream
         {
             GetStreamFile().Clear(aRemoveFile);
         }
+        else if (IsStreamDescriptor())
+        {
+            GetStreamDescriptor().Clear();
+        }
+        else if (IsStreamGather())
+        {
+            GetStreamGather().Clear();
+        }
+        else if (IsStreamCompressed())
+        {
+            GetStreamCompressed().Clear(aRemoveFile);
+        }
         else if (IsStream())
         {
             GetStream().clear();
             GetStream().shrink_to_fit();
         }
+        else if (IsBuffer())
+        {
+            GetBuffer() = {};
+        }
 
         mReadIndex = {};
+        mChecksum = {};
 
         return *this;
     }
@@ -192,6 +578,9 @@ class Stream
     stream mStream;
     Size::size_max mReadIndex{};
 
+    // the CRC32C of the bytes written/read since BeginChecksum
+    std::optional<uint32_t> mChecksum{};
+
     constexpr bool IsView() const noexcept
     {
         return std::holds_alternative<span>(mStream);
@@ -207,6 +596,64 @@ class Stream
         return std::holds_alternative<StreamFile>(mStream);
     }
 
+    constexpr bool IsStreamDescriptor() const noexcept
+    {
+        return std::holds_alternative<StreamDescriptor>(mStream);
+    }
+
+    constexpr bool IsStreamGather() const noexcept
+    {
+        return std::holds_alternative<StreamGather>(mStream);
+    }
+
+    constexpr bool IsStreamCompressed() const noexcept
+    {
+        return std::holds_alternative<StreamCompressed>(mStream);
+    }
+
+    // the size of the buffer the bytes go through, 0 when the stream is in memory
+    constexpr Size::size_max GetBufferSize() const noexcept
+    {
+        if (IsStreamFile())
+        {
+            return StreamFile::BUFFER_SIZE;
+        }
+        else if (IsStreamDescriptor())
+        {
+            return StreamDescriptor::BUFFER_SIZE;
+        }
+        else if (IsStreamCompressed())
+        {
+            return StreamCompressed::CHUNK_SIZE;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    // the count of the bytes left to read, the maximum when they are not known before they are read (ex.: a pipe)
+    constexpr Size::size_max GetSizeLeft() noexcept
+    {
+        if (IsStreamFile())
+        {
+            return GetStreamFile().GetSizeLeft();
+        }
+        else if (IsStreamDescriptor() || IsStreamGather() || IsStreamCompressed())
+        {
+            return std::numeric_limits<Size::size_max>::max();
+        }
+        else
+        {
+            return View().size() - mReadIndex;
+        }
+    }
+
+    constexpr bool IsBuffer() const noexcept
+    {
+        return std::holds_alternative<buffer>(mStream);
+    }
+
     constexpr vector &GetStream() noexcept
     {
         assert(IsStream());
@@ -224,5 +671,65 @@ class Stream
         assert(IsStreamFile());
         return std::get<StreamFile>(mStream);
     }
+
+    constexpr StreamDescriptor &GetStreamDescriptor() noexcept
+    {
+        assert(IsStreamDescriptor());
+        return std::get<StreamDescriptor>(mStream);
+    }
+
+    constexpr StreamGather &GetStreamGather() noexcept
+    {
+        assert(IsStreamGather());
+        return std::get<StreamGather>(mStream);
+    }
+
+    constexpr StreamCompressed &GetStreamCompressed() noexcept
+    {
+        assert(IsStreamCompressed());
+        return std::get<StreamCompressed>(mStream);
+    }
+
+    constexpr void UpdateChecksum(const span aBytes) noexcept
+    {
+        if (mChecksum)
+        {
+            mChecksum = Crc32c::Extend(*mChecksum, aBytes);
+        }
+    }
+
+    // writes the bytes of an object that outlives the stream so the gather can reference them
+    constexpr decltype(auto) WriteReference(const span aSpan)
+    {
+        if (IsStreamGather())
+        {
+            UpdateChecksum(aSpan);
+            GetStreamGather().WriteReference(aSpan);
+            return *this;
+        }
+
+        return Write(aSpan);
+    }
+
+    // continues with the spans of the other gather
+    Stream &Append(Stream &&aStream)
+    {
+        if (mChecksum)
+        {
+            for (const auto bytes : aStream.Gather())
+            {
+                UpdateChecksum(bytes);
+            }
+        }
+
+        GetStreamGather().Append(std::move(aStream.GetStreamGather()));
+        return *this;
+    }
+
+    constexpr buffer &GetBuffer() noexcept
+    {
+        assert(IsBuffer());
+        return std::get<buffer>(mStream);
+    }
 };
 } // namespace hbann
@@ -0,0 +1,492 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "Utilities/LzCompressor.h"
+
+namespace hbann
+{
+// The compression of the chunks, ZSTD and LZ4 are available when STREAMABLE_USE_ZSTD/STREAMABLE_USE_LZ4 are defined
+// before including the library (that must be linked with them)
+enum class CompressionType : uint8_t
+{
+    NONE,
+    LZ,
+    ZSTD,
+    LZ4
+};
+
+/*
+    A stream whose bytes are compressed in chunks when serializing and decompressed when deserializing, ex.:
+        ::hbann::Stream stream(::hbann::StreamCompressed(::hbann::Stream(path, ::hbann::StreamUsageType::SERIALIZE)));
+        ::hbann::StreamWriter(stream).WriteAll(snapshot);
+        stream.Clear(); // writes the last chunk
+
+    The chunks are compressed when they are full (or flushed) and are read one at a time so the stream can be of any
+   size, the ones that don't get smaller are stored as they are. The last chunk is written by Flush, Clear or Release
+   so the bytes after the last full chunk of a stream destroyed without them (ex.: an exception was thrown) are lost.
+
+    Format: chunks of the type + the size + the size compressed (4 bytes little endian) + the bytes compressed
+*/
+template <typename StreamType> class BasicStreamCompressed
+{
+    friend StreamType;
+
+    using vector = std::vector<uint8_t>;
+    using span = std::span<const uint8_t>;
+
+  public:
+    static inline constexpr Size::size_max CHUNK_SIZE = 64 * 1024;
+    static inline constexpr Size::size_max CHUNK_SIZE_MAX = 64 * 1024 * 1024;
+    static inline constexpr Size::size_max HEADER_SIZE = 1 + sizeof(uint32_t) * 2;
+
+#ifdef STREAMABLE_HAS_ZSTD
+    static inline constexpr int ZSTD_LEVEL = 1;
+#endif // STREAMABLE_HAS_ZSTD
+
+    // Only used by Stream's std::variant rules
+    BasicStreamCompressed(const BasicStreamCompressed &)
+    {
+        assert(false);
+    }
+
+    // the chunk size is used only when serializing, the bigger ones compress better but use more memory
+    explicit BasicStreamCompressed(StreamType &&aStream, const CompressionType aCompressionType = CompressionType::LZ,
+                                   const Size::size_max aChunkSize = CHUNK_SIZE)
+        : mStreamUsageType(aStream.mStreamUsageType), mStream(std::make_unique<StreamType>(std::move(aStream))),
+          mCompressionType(aCompressionType), mChunkSize(std::clamp<Size::size_max>(aChunkSize, 1, CHUNK_SIZE_MAX))
+    {
+        assert(IsSupported(aCompressionType));
+    }
+
+    explicit BasicStreamCompressed(BasicStreamCompressed &&aStreamCompressed) noexcept
+    {
+        *this = std::move(aStreamCompressed);
+    }
+
+    // the state is swapped so the bytes of each stream stay with it
+    BasicStreamCompressed &operator=(BasicStreamCompressed &&aStreamCompressed) noexcept
+    {
+        std::swap(mStreamUsageType, aStreamCompressed.mStreamUsageType);
+        std::swap(mCompressionType, aStreamCompressed.mCompressionType);
+        std::swap(mChunkSize, aStreamCompressed.mChunkSize);
+
+        std::swap(mStream, aStreamCompressed.mStream);
+        std::swap(mBuffer, aStreamCompressed.mBuffer);
+        std::swap(mEncoded, aStreamCompressed.mEncoded);
+
+        std::swap(mBegin, aStreamCompressed.mBegin);
+        std::swap(mEnd, aStreamCompressed.mEnd);
+        std::swap(mReadIndex, aStreamCompressed.mReadIndex);
+        std::swap(mPeeks, aStreamCompressed.mPeeks);
+        std::swap(mEOS, aStreamCompressed.mEOS);
+
+        return *this;
+    }
+
+    [[nodiscard]] static constexpr bool IsSupported(const CompressionType aCompressionType) noexcept
+    {
+        if (aCompressionType == CompressionType::NONE || aCompressionType == CompressionType::LZ)
+        {
+            return true;
+        }
+#ifdef STREAMABLE_HAS_ZSTD
+        else if (aCompressionType == CompressionType::ZSTD)
+        {
+            return true;
+        }
+#endif // STREAMABLE_HAS_ZSTD
+#ifdef STREAMABLE_HAS_LZ4
+        else if (aCompressionType == CompressionType::LZ4)
+        {
+            return true;
+        }
+#endif // STREAMABLE_HAS_LZ4
+        else
+        {
+            return false;
+        }
+    }
+
+  private:
+    StreamUsageType mStreamUsageType{};
+
+    // the stream is not complete here so it is kept by a pointer
+    std::unique_ptr<StreamType> mStream{};
+
+    CompressionType mCompressionType{};
+    Size::size_max mChunkSize{};
+
+    // the bytes between begin and end are decompressed ahead when deserializing and are not compressed yet when
+    // serializing (from the start of the buffer)
+    vector mBuffer{};
+    Size::size_max mBegin{};
+    Size::size_max mEnd{};
+
+    // the chunk with its header as it is in the stream
+    vector mEncoded{};
+
+    Size::size_max mReadIndex{};
+    size_t mPeeks{};
+    bool mEOS{};
+
+    vector &&Release()
+    {
+        Drain();
+        return mStream->Release();
+    }
+
+    template <typename FunctionSeek>
+    BasicStreamCompressed &Peek(FunctionSeek &&aFunctionSeek, const Size::size_max aOffset = 0)
+    {
+        // the bytes read while peeking are kept in the buffer to be read again
+        mPeeks++;
+
+        const auto begin = mBegin;
+        const auto readIndex = mReadIndex;
+        (void)Read(aOffset);
+        aFunctionSeek(readIndex);
+
+        mBegin = begin;
+        mReadIndex = readIndex;
+        mPeeks--;
+
+        return *this;
+    }
+
+    BasicStreamCompressed &Reserve(const Size::size_max)
+    {
+        // the bytes are compressed a chunk at a time
+        return *this;
+    }
+
+    // the span is valid until the next call
+    [[nodiscard]] span Read(const Size::size_max aSize)
+    {
+        Fill(aSize);
+
+        const auto size = std::min(aSize, mEnd - mBegin);
+        const span bytes(mBuffer.data() + mBegin, size);
+
+        mBegin += size;
+        mReadIndex += size;
+
+        return bytes;
+    }
+
+    // reads into the bytes a chunk at a time, returns the count of the bytes read
+    Size::size_max ReadInto(const std::span<uint8_t> aBytes)
+    {
+        Size::size_max size{};
+        while (size < aBytes.size())
+        {
+            Fill(1);
+
+            const auto bytes = Read(std::min(aBytes.size() - size, mEnd - mBegin));
+            if (bytes.empty())
+            {
+                break;
+            }
+
+            std::memcpy(aBytes.data() + size, bytes.data(), bytes.size());
+            size += bytes.size();
+        }
+
+        return size;
+    }
+
+    auto Current()
+    {
+        Fill(1);
+        return mBegin < mEnd ? mBuffer[mBegin] : uint8_t{};
+    }
+
+    bool IsEOS()
+    {
+        Fill(1);
+        return mBegin == mEnd;
+    }
+
+    BasicStreamCompressed &Write(span aSpan)
+    {
+        while (!aSpan.empty())
+        {
+            // the whole chunks are compressed straight from the bytes
+            if (!mEnd && aSpan.size() >= mChunkSize)
+            {
+                WriteChunk(aSpan.first(mChunkSize));
+                aSpan = aSpan.subspan(mChunkSize);
+
+                continue;
+            }
+
+            if (mBuffer.size() < mChunkSize)
+            {
+                mBuffer.resize(mChunkSize);
+            }
+
+            const auto size = std::min(aSpan.size(), mChunkSize - mEnd);
+            std::memcpy(mBuffer.data() + mEnd, aSpan.data(), size);
+            mEnd += size;
+            aSpan = aSpan.subspan(size);
+
+            if (mEnd == mChunkSize)
+            {
+                Drain();
+            }
+        }
+
+        return *this;
+    }
+
+    // makes the bytes written durable, it can be called while another thread writes (see Flush)
+    [[nodiscard]] bool Sync() noexcept
+    {
+        return mStream->Sync();
+    }
+
+    [[nodiscard]] bool HasFailed() const noexcept
+    {
+        return mStream && mStream->HasFailed();
+    }
+
+    // compresses the bytes written into a chunk (smaller than the others) and writes it
+    BasicStreamCompressed &Drain()
+    {
+        if (mStream && mStreamUsageType == StreamUsageType::SERIALIZE && mEnd)
+        {
+            WriteChunk({mBuffer.data(), mEnd});
+            mEnd = 0;
+        }
+
+        return *this;
+    }
+
+    BasicStreamCompressed &Flush()
+    {
+        Drain();
+        mStream->Flush();
+
+        return *this;
+    }
+
+    BasicStreamCompressed &Clear(const bool aRemoveFile = false)
+    {
+        if (mStream)
+        {
+            if (!aRemoveFile)
+            {
+                Drain();
+            }
+
+            mStream->Clear(aRemoveFile);
+        }
+
+        mBuffer = {};
+        mEncoded = {};
+
+        mBegin = {};
+        mEnd = {};
+        mReadIndex = {};
+        mPeeks = {};
+        mEOS = {};
+
+        return *this;
+    }
+
+    void WriteChunk(const span aBytes)
+    {
+        mEncoded.resize(HEADER_SIZE);
+
+        auto compressionType = mCompressionType;
+        if (!Encode(compressionType, aBytes) || mEncoded.size() - HEADER_SIZE >= aBytes.size())
+        {
+            // the bytes that don't get smaller are stored as they are after the header
+            compressionType = CompressionType::NONE;
+            mEncoded.resize(HEADER_SIZE);
+        }
+
+        const auto sizeEncoded =
+            compressionType == CompressionType::NONE ? aBytes.size() : mEncoded.size() - HEADER_SIZE;
+        mEncoded[0] = static_cast<uint8_t>(compressionType);
+        WriteNumber(mEncoded.data() + 1, aBytes.size());
+        WriteNumber(mEncoded.data() + 1 + sizeof(uint32_t), sizeEncoded);
+
+        mStream->Write(mEncoded);
+        if (compressionType == CompressionType::NONE)
+        {
+            mStream->Write(aBytes);
+        }
+    }
+
+    // decompresses the next chunk after the buffered bytes, returns false at the end of the stream or when the chunk
+    // is corrupted or truncated
+    bool ReadChunk()
+    {
+        std::array<uint8_t, HEADER_SIZE> header{};
+        if (mStream->ReadInto(header) != header.size())
+        {
+            return false;
+        }
+
+        const auto compressionType = static_cast<CompressionType>(header[0]);
+        const auto size = ReadNumber(header.data() + 1);
+        const auto sizeEncoded = ReadNumber(header.data() + 1 + sizeof(uint32_t));
+        if (size > CHUNK_SIZE_MAX || sizeEncoded > size)
+        {
+            return false;
+        }
+
+        if (mBuffer.size() < mEnd + size)
+        {
+            mBuffer.resize(mEnd + size);
+        }
+
+        const std::span decoded(mBuffer.data() + mEnd, size);
+        if (compressionType == CompressionType::NONE)
+        {
+            if (sizeEncoded != size || mStream->ReadInto(decoded) != size)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            mEncoded.resize(sizeEncoded);
+            if (mStream->ReadInto(mEncoded) != sizeEncoded || !Decode(compressionType, mEncoded, decoded))
+            {
+                return false;
+            }
+        }
+
+        mEnd += size;
+        return true;
+    }
+
+    // makes the count of bytes available decompressing as many chunks as needed (less at the end of the stream)
+    void Fill(const Size::size_max aCount)
+    {
+        if (mEnd - mBegin >= aCount || mEOS)
+        {
+            return;
+        }
+
+        // the bytes that were read are dropped unless they are peeked
+        if (!mPeeks && mBegin)
+        {
+            std::memmove(mBuffer.data(), mBuffer.data() + mBegin, mEnd - mBegin);
+            mEnd -= mBegin;
+            mBegin = 0;
+        }
+
+        while (mEnd - mBegin < aCount)
+        {
+            if (!ReadChunk())
+            {
+                mEOS = true;
+                break;
+            }
+        }
+    }
+
+    // appends the compressed bytes to the encoded ones, returns false when it failed
+    bool Encode(const CompressionType aCompressionType, const span aBytes)
+    {
+        [[maybe_unused]] const auto offset = mEncoded.size();
+        if (aCompressionType == CompressionType::LZ)
+        {
+            LzCompressor::Encode(aBytes, mEncoded);
+            return true;
+        }
+#ifdef STREAMABLE_HAS_ZSTD
+        else if (aCompressionType == CompressionType::ZSTD)
+        {
+            mEncoded.resize(offset + ZSTD_compressBound(aBytes.size()));
+            const auto size = ZSTD_compress(mEncoded.data() + offset, mEncoded.size() - offset, aBytes.data(),
+                                            aBytes.size(), ZSTD_LEVEL);
+            if (ZSTD_isError(size))
+            {
+                return false;
+            }
+
+            mEncoded.resize(offset + size);
+            return true;
+        }
+#endif // STREAMABLE_HAS_ZSTD
+#ifdef STREAMABLE_HAS_LZ4
+        else if (aCompressionType == CompressionType::LZ4)
+        {
+            const auto capacity = LZ4_compressBound(static_cast<int>(aBytes.size()));
+            mEncoded.resize(offset + static_cast<Size::size_max>(capacity));
+            const auto size = LZ4_compress_default(reinterpret_cast<const char *>(aBytes.data()),
+                                                   reinterpret_cast<char *>(mEncoded.data() + offset),
+                                                   static_cast<int>(aBytes.size()), capacity);
+            if (size <= 0)
+            {
+                return false;
+            }
+
+            mEncoded.resize(offset + static_cast<Size::size_max>(size));
+            return true;
+        }
+#endif // STREAMABLE_HAS_LZ4
+        else
+        {
+            return false;
+        }
+    }
+
+    // decompresses the encoded bytes into the decoded ones that have their size, returns false when they are
+    // corrupted or the compression is not supported
+    [[nodiscard]] static bool Decode(const CompressionType aCompressionType, const span aEncoded,
+                                     const std::span<uint8_t> aDecoded) noexcept
+    {
+        if (aCompressionType == CompressionType::LZ)
+        {
+            return LzCompressor::Decode(aEncoded, aDecoded);
+        }
+#ifdef STREAMABLE_HAS_ZSTD
+        else if (aCompressionType == CompressionType::ZSTD)
+        {
+            const auto size = ZSTD_decompress(aDecoded.data(), aDecoded.size(), aEncoded.data(), aEncoded.size());
+            return !ZSTD_isError(size) && size == aDecoded.size();
+        }
+#endif // STREAMABLE_HAS_ZSTD
+#ifdef STREAMABLE_HAS_LZ4
+        else if (aCompressionType == CompressionType::LZ4)
+        {
+            return LZ4_decompress_safe(reinterpret_cast<const char *>(aEncoded.data()),
+                                       reinterpret_cast<char *>(aDecoded.data()), static_cast<int>(aEncoded.size()),
+                                       static_cast<int>(aDecoded.size())) == static_cast<int>(aDecoded.size());
+        }
+#endif // STREAMABLE_HAS_LZ4
+        else
+        {
+            return false;
+        }
+    }
+
+    static void WriteNumber(uint8_t *aBytes, const Size::size_max aNumber) noexcept
+    {
+        for (size_t i = 0; i < sizeof(uint32_t); i++)
+        {
+            aBytes[i] = static_cast<uint8_t>(aNumber >> (i * 8));
+        }
+    }
+
+    [[nodiscard]] static Size::size_max ReadNumber(const uint8_t *aBytes) noexcept
+    {
+        Size::size_max number{};
+        for (size_t i = 0; i < sizeof(uint32_t); i++)
+        {
+            number |= static_cast<Size::size_max>(aBytes[i]) << (i * 8);
+        }
+
+        return number;
+    }
+};
+} // namespace hbann
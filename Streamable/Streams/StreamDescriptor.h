@@ -0,0 +1,466 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "Utilities/File.h"
+
+namespace hbann
+{
+/*
+    A file descriptor (or a Windows handle) that can't seek like stdin/stdout, a pipe or a socket, ex.:
+        ::hbann::Stream stream(STDIN_FILENO, ::hbann::StreamUsageType::DESERIALIZE);
+        ::hbann::StreamReader(stream).ReadAll(objects...);
+
+    The deserialization reads ahead as much as fits in the buffer and the big reads go straight into the destination
+   with the buffer filled by the same system call. The serialization gathers the buffered bytes and the big writes in a
+   single system call without copying them.
+
+    The descriptors that are not blocking are waited for when they are not ready.
+
+    A write that fails (ex.: the other side closed the pipe or the socket) fails the stream (see HasFailed) and the
+   bytes after it are lost. The sockets are written without raising SIGPIPE where it is supported (MSG_NOSIGNAL) but
+   the pipes raise it, so the process must ignore it (ex.: signal(SIGPIPE, SIG_IGN)) for the write to fail instead of
+   the process ending.
+*/
+class StreamDescriptor
+{
+    friend class Stream;
+
+    using vector = std::vector<uint8_t>;
+    using span = std::span<const uint8_t>;
+
+  public:
+    static inline constexpr Size::size_max BUFFER_SIZE = 64 * 1024;
+
+    // Only used by Stream's std::variant rules
+    StreamDescriptor(const StreamDescriptor &)
+    {
+        assert(false);
+    }
+
+    // the descriptor is closed by the stream only when it is owned
+    explicit StreamDescriptor(const File::handle aHandle, const StreamUsageType aStreamUsageType, const bool aOwn)
+        : mStreamUsageType(aStreamUsageType), mFile(aHandle), mOwn(aOwn), mBuffer(BUFFER_SIZE)
+    {
+#ifndef _WIN32
+        struct stat status{};
+        mSocket = !fstat(aHandle, &status) && S_ISSOCK(status.st_mode);
+#endif // !_WIN32
+    }
+
+    explicit StreamDescriptor(StreamDescriptor &&aStreamDescriptor) noexcept
+    {
+        *this = std::move(aStreamDescriptor);
+    }
+
+    ~StreamDescriptor() noexcept
+    {
+        Clear();
+    }
+
+    StreamDescriptor &operator=(StreamDescriptor &&aStreamDescriptor) noexcept
+    {
+        mStreamUsageType = aStreamDescriptor.mStreamUsageType;
+
+        std::swap(mFile, aStreamDescriptor.mFile);
+        std::swap(mOwn, aStreamDescriptor.mOwn);
+        std::swap(mSocket, aStreamDescriptor.mSocket);
+        std::swap(mBuffer, aStreamDescriptor.mBuffer);
+
+        mBegin = aStreamDescriptor.mBegin;
+        mEnd = aStreamDescriptor.mEnd;
+        mReadIndex = aStreamDescriptor.mReadIndex;
+        mPeeks = aStreamDescriptor.mPeeks;
+        mEOS = aStreamDescriptor.mEOS;
+        mFailed = aStreamDescriptor.mFailed.load();
+
+        return *this;
+    }
+
+  private:
+    StreamUsageType mStreamUsageType{};
+
+    File mFile;
+    bool mOwn{};
+    bool mSocket{};
+
+    // the bytes between begin and end are read ahead when deserializing and are not written yet when serializing
+    vector mBuffer;
+    Size::size_max mBegin{};
+    Size::size_max mEnd{};
+
+    Size::size_max mReadIndex{};
+    size_t mPeeks{};
+    bool mEOS{};
+
+    // it is read by Sync while another thread writes
+    std::atomic<bool> mFailed{};
+
+    vector &&Release() noexcept
+    {
+        return std::move(mBuffer);
+    }
+
+    template <typename FunctionSeek>
+    StreamDescriptor &Peek(FunctionSeek &&aFunctionSeek, const Size::size_max aOffset = 0)
+    {
+        // the bytes read while peeking are kept in the buffer to be read again
+        mPeeks++;
+
+        const auto begin = mBegin;
+        const auto readIndex = mReadIndex;
+        (void)Read(aOffset);
+        aFunctionSeek(readIndex);
+
+        mBegin = begin;
+        mReadIndex = readIndex;
+        mPeeks--;
+
+        return *this;
+    }
+
+    StreamDescriptor &Reserve(const Size::size_max)
+    {
+        // the bytes are written through the buffer
+        return *this;
+    }
+
+    // the span is valid until the next call
+    [[nodiscard]] span Read(const Size::size_max aSize)
+    {
+        Fill(aSize);
+
+        const auto size = std::min(aSize, mEnd - mBegin);
+        const span bytes(mBuffer.data() + mBegin, size);
+
+        mBegin += size;
+        mReadIndex += size;
+
+        return bytes;
+    }
+
+    // reads into the bytes, the big reads go straight into them, returns the count of the bytes read
+    Size::size_max ReadInto(const std::span<uint8_t> aBytes)
+    {
+        auto size = std::min<Size::size_max>(aBytes.size(), mEnd - mBegin);
+        std::memcpy(aBytes.data(), mBuffer.data() + mBegin, size);
+        mBegin += size;
+
+        if (aBytes.size() - size < BUFFER_SIZE || mPeeks)
+        {
+            const auto bytes = Read(aBytes.size() - size);
+            std::memcpy(aBytes.data() + size, bytes.data(), bytes.size());
+
+            mReadIndex += size;
+            return size + bytes.size();
+        }
+
+        // the rest of the bytes and the buffer after them are filled by the same reads
+        mBegin = mEnd = 0;
+        while (size < aBytes.size() && !mEOS)
+        {
+            const auto count = Transfer({aBytes.subspan(size), std::span(mBuffer)}, false);
+            if (!count)
+            {
+                mEOS = true;
+            }
+
+            const auto countBytes = std::min<Size::size_max>(count, aBytes.size() - size);
+            size += countBytes;
+            mEnd += count - countBytes;
+        }
+
+        mReadIndex += size;
+        return size;
+    }
+
+    auto Current()
+    {
+        Fill(1);
+        return mBegin < mEnd ? mBuffer[mBegin] : uint8_t{};
+    }
+
+    bool IsEOS()
+    {
+        Fill(1);
+        return mBegin == mEnd;
+    }
+
+    StreamDescriptor &Write(const span aSpan)
+    {
+        if (mEnd + aSpan.size() <= mBuffer.size())
+        {
+            std::memcpy(mBuffer.data() + mEnd, aSpan.data(), aSpan.size());
+            mEnd += aSpan.size();
+
+            return *this;
+        }
+
+        // the buffered bytes are written with the bytes that don't fit without copying them
+        Transfer({std::span(mBuffer.data(), mEnd), std::span(const_cast<uint8_t *>(aSpan.data()), aSpan.size())},
+                 true);
+        mEnd = 0;
+
+        return *this;
+    }
+
+    // writes the bytes of the file region after the buffered ones, they are moved in the kernel when the descriptor
+    // can do it and read into the buffer otherwise, returns the count of the bytes written
+    Size::size_max WriteRegion(File &aFile, const Size::size_max aOffset, const Size::size_max aSize)
+    {
+        Drain();
+
+        auto size = aFile.SendTo(mFile, aOffset, {}, aSize);
+        while (size < aSize)
+        {
+            const auto count = aFile.ReadAt(std::span(mBuffer).first(std::min(mBuffer.size(), aSize - size)),
+                                            aOffset + size);
+            if (!count)
+            {
+                break;
+            }
+
+            if (Transfer({std::span(mBuffer.data(), count), {}}, true) < count)
+            {
+                break;
+            }
+
+            size += count;
+        }
+
+        return size;
+    }
+
+    // reads the bytes into the file region, the ones read ahead are written first and the rest are moved in the
+    // kernel when the descriptor can do it (ex.: a pipe) and read into the buffer otherwise, returns the count of the
+    // bytes read
+    Size::size_max ReadRegion(File &aFile, const Size::size_max aOffset, const Size::size_max aSize)
+    {
+        Size::size_max size{};
+        const auto write = [&](const span aBytes) {
+            const auto count = aFile.WriteAt(aBytes, aOffset + size);
+            size += count;
+
+            return count == aBytes.size();
+        };
+
+        if (!write(Read(std::min(aSize, mEnd - mBegin))))
+        {
+            return size;
+        }
+
+        // the bytes that are peeked must stay in the buffer
+        if (!mPeeks && size < aSize)
+        {
+            const auto count = mFile.SendTo(aFile, {}, aOffset + size, aSize - size);
+            size += count;
+            mReadIndex += count;
+        }
+
+        while (size < aSize)
+        {
+            const auto bytes = Read(std::min(aSize - size, BUFFER_SIZE));
+            if (bytes.empty() || !write(bytes))
+            {
+                break;
+            }
+        }
+
+        return size;
+    }
+
+    // the buffers are not used so it can be done while writing, it fails when a write failed before
+    [[nodiscard]] bool Sync() const noexcept
+    {
+        return mFile.Sync() && !mFailed;
+    }
+
+    [[nodiscard]] bool HasFailed() const noexcept
+    {
+        return mFailed;
+    }
+
+    // writes the buffered bytes
+    StreamDescriptor &Drain()
+    {
+        if (mStreamUsageType == StreamUsageType::SERIALIZE && mEnd)
+        {
+            Transfer({std::span(mBuffer.data(), mEnd), {}}, true);
+            mEnd = 0;
+        }
+
+        return *this;
+    }
+
+    StreamDescriptor &Clear(const bool = false)
+    {
+        if (mFile.IsOpen())
+        {
+            Drain();
+
+            if (!mOwn)
+            {
+                (void)mFile.Release();
+            }
+
+            mFile.Close();
+        }
+
+        mBuffer.clear();
+        mBuffer.shrink_to_fit();
+
+        mBegin = {};
+        mEnd = {};
+        mReadIndex = {};
+        mPeeks = {};
+        mEOS = {};
+
+        return *this;
+    }
+
+    // makes the count of bytes available reading ahead as much as fits in the buffer (less at the end of the stream)
+    void Fill(const Size::size_max aCount)
+    {
+        if (mEnd - mBegin >= aCount || mEOS)
+        {
+            return;
+        }
+
+        // the bytes that were read are dropped unless they are peeked
+        if (!mPeeks && mBegin)
+        {
+            std::memmove(mBuffer.data(), mBuffer.data() + mBegin, mEnd - mBegin);
+            mEnd -= mBegin;
+            mBegin = 0;
+        }
+
+        if (mBuffer.size() < mBegin + aCount)
+        {
+            mBuffer.resize(mBegin + aCount);
+        }
+
+        while (mEnd - mBegin < aCount)
+        {
+            const auto count = Transfer({std::span(mBuffer).subspan(mEnd), {}}, false);
+            if (!count)
+            {
+                mEOS = true;
+                break;
+            }
+
+            mEnd += count;
+        }
+    }
+
+    // reads once into the buffers one after another or writes them all, returns the count of the bytes transferred
+    // that is 0 at the end of the stream or when it failed
+    Size::size_max Transfer(std::array<std::span<uint8_t>, 2> aBuffers, const bool aWrite)
+    {
+#ifdef _WIN32
+        // the handles are read/written without overlapping so the buffers are transferred one at a time
+        Size::size_max size{};
+        for (auto &buffer : aBuffers)
+        {
+            while (!buffer.empty())
+            {
+                DWORD transferred{};
+                const auto count = static_cast<DWORD>(std::min<Size::size_max>(buffer.size(), 1 << 30));
+                const auto result = aWrite ? WriteFile(mFile.GetHandle(), buffer.data(), count, &transferred, nullptr)
+                                           : ReadFile(mFile.GetHandle(), buffer.data(), count, &transferred, nullptr);
+                if (!result || !transferred)
+                {
+                    mFailed = mFailed || aWrite;
+                    return size;
+                }
+
+                size += transferred;
+                buffer = buffer.subspan(transferred);
+
+                if (!aWrite)
+                {
+                    return size;
+                }
+            }
+        }
+
+        return size;
+#else
+        std::array<iovec, 2> iovecs{};
+        for (size_t i = 0; i < iovecs.size(); i++)
+        {
+            iovecs[i] = {aBuffers[i].data(), aBuffers[i].size()};
+        }
+
+        Size::size_max size{};
+        for (size_t index = iovecs[0].iov_len ? 0 : 1; index < iovecs.size() && iovecs[index].iov_len;)
+        {
+            const auto count = static_cast<int>(iovecs.size() - index);
+            const auto transferred = aWrite ? Send(iovecs.data() + index, count)
+                                            : readv(mFile.GetHandle(), iovecs.data() + index, count);
+            if (transferred < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (transferred < 0 && errno == EAGAIN)
+            {
+                pollfd descriptor{mFile.GetHandle(), static_cast<short>(aWrite ? POLLOUT : POLLIN), 0};
+                poll(&descriptor, 1, -1);
+                continue;
+            }
+
+            if (transferred <= 0)
+            {
+                mFailed = mFailed || aWrite;
+                break;
+            }
+
+            size += static_cast<Size::size_max>(transferred);
+            if (!aWrite)
+            {
+                break;
+            }
+
+            // the writes can be partial so we continue after the bytes written
+            for (auto left = static_cast<size_t>(transferred); left && index < iovecs.size();)
+            {
+                const auto written = std::min(left, iovecs[index].iov_len);
+                iovecs[index].iov_base = static_cast<uint8_t *>(iovecs[index].iov_base) + written;
+                iovecs[index].iov_len -= written;
+                left -= written;
+
+                if (!iovecs[index].iov_len)
+                {
+                    index++;
+                }
+            }
+        }
+
+        return size;
+#endif // _WIN32
+    }
+
+#ifndef _WIN32
+    // writes the buffers once, the sockets closed by the other side fail the write instead of raising SIGPIPE
+    ssize_t Send(iovec *aIovecs, const int aCount) noexcept
+    {
+#ifdef MSG_NOSIGNAL
+        if (mSocket)
+        {
+            msghdr message{};
+            message.msg_iov = aIovecs;
+            message.msg_iovlen = static_cast<decltype(message.msg_iovlen)>(aCount);
+
+            return sendmsg(mFile.GetHandle(), &message, MSG_NOSIGNAL);
+        }
+#endif // MSG_NOSIGNAL
+
+        return writev(mFile.GetHandle(), aIovecs, aCount);
+    }
+#endif // !_WIN32
+};
+} // namespace hbann
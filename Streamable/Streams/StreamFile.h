@@ -6,44 +6,63 @@
 
 #pragma once
 
-#include "Utilities/Size.h"
+#include "Utilities/FileRing.h"
 
 namespace hbann
 {
+/*
+    A file serialized/deserialized through 2 buffers with the transfers in the background (see FileRing):
+        - the serialization fills a buffer while the other one is written
+        - the deserialization consumes a buffer while the next part of the file is read into the other one
+
+    The durable serialization writes a new temporary file next to the file (see File::CreateTemporary) that replaces
+   it only when the stream is cleared after all of its bytes are written and synced, so a crash, an exception or a
+   failed write (see HasFailed) leaves the old file or the new one but never a part of it.
+
+    A transfer that ends before all of its bytes (ex.: the disk is full or a read failed) fails the stream (see
+   HasFailed) and the bytes after it are lost.
+*/
 class StreamFile
 {
     friend class Stream;
 
-    using fstream = std::basic_fstream<uint8_t>;
     using vector = std::vector<uint8_t>;
     using span = std::span<const uint8_t>;
 
   public:
+    static inline constexpr Size::size_max BUFFER_SIZE = 256 * 1024;
+
     // Only used by Stream's std::variant rules
     StreamFile(const StreamFile &)
     {
         assert(false);
     }
 
-    explicit StreamFile(const std::filesystem::path &aPath, const StreamUsageType aStreamUsageType) : mPath(aPath)
+    // the serialization appends to the end of the file when it is not truncated or replaces it when it is durable
+    explicit StreamFile(const std::filesystem::path &aPath, const StreamUsageType aStreamUsageType,
+                        const bool aAppend = false, const bool aDurable = false)
+        : mPath(aPath), mStreamUsageType(aStreamUsageType), mDurable(aDurable)
     {
-        switch (aStreamUsageType)
-        {
-            using enum StreamUsageType;
+        assert(!aDurable || (aStreamUsageType == StreamUsageType::SERIALIZE && !aAppend));
+        mFile = mDurable ? File::CreateTemporary(mPath, mPathTemporary) : File(mPath, aStreamUsageType, aAppend);
 
-        case SERIALIZE:
-            mStream = fstream(mPath, std::ios_base::out | std::ios_base::binary);
-            break;
+        for (auto &buffer : mBuffers)
+        {
+            buffer = std::make_unique_for_overwrite<uint8_t[]>(BUFFER_SIZE);
+        }
 
-        case DESERIALIZE:
-            mStream = fstream(mPath, std::ios_base::in | std::ios_base::binary);
-            break;
+        const std::array buffers{GetBuffer(0), GetBuffer(1)};
+        mFileRing = FileRing(buffers);
 
-        default:
-            assert(false);
+        if (mStreamUsageType == StreamUsageType::DESERIALIZE)
+        {
+            mFileSize = mFile.GetSize();
+            Seek(0);
+        }
+        else if (aAppend)
+        {
+            mWindow = {mFile.GetSize(), 0};
         }
-
-        assert(mStream);
     }
 
     explicit StreamFile(StreamFile &&aStreamFile) noexcept
@@ -51,17 +70,70 @@ class StreamFile
         *this = std::move(aStreamFile);
     }
 
+    // the durable file replaces the old one only when it is cleared (see Clear) so the file of a serialization that
+    // didn't finish (ex.: an exception was thrown) is discarded
+    ~StreamFile() noexcept
+    {
+        Clear(mDurable);
+    }
+
+    // the state is swapped so the moved from stream clears the file that was in this one
     StreamFile &operator=(StreamFile &&aStreamFile) noexcept
     {
-        mPath = std::move(aStreamFile.mPath);
-        mStream = std::move(aStreamFile.mStream);
-        mBuffer = std::move(aStreamFile.mBuffer);
-        mReadIndex = aStreamFile.mReadIndex;
+        std::swap(mPath, aStreamFile.mPath);
+        std::swap(mPathTemporary, aStreamFile.mPathTemporary);
+        std::swap(mStreamUsageType, aStreamFile.mStreamUsageType);
+        std::swap(mDurable, aStreamFile.mDurable);
+
+        // the transfers in flight are moved with the buffers they use
+        std::swap(mFile, aStreamFile.mFile);
+        std::swap(mBuffers, aStreamFile.mBuffers);
+        std::swap(mFileRing, aStreamFile.mFileRing);
+
+        std::swap(mBuffer, aStreamFile.mBuffer);
+        mFailed = aStreamFile.mFailed.exchange(mFailed);
+        std::swap(mFileSize, aStreamFile.mFileSize);
+        std::swap(mReadIndex, aStreamFile.mReadIndex);
+        std::swap(mCurrent, aStreamFile.mCurrent);
+        std::swap(mWindow, aStreamFile.mWindow);
 
         return *this;
     }
 
   private:
+    // the part of the file that is in the current buffer, when serializing the size is how much was written in it
+    struct window
+    {
+        Size::size_max offset{};
+        Size::size_max size{};
+
+        [[nodiscard]] constexpr Size::size_max End() const noexcept
+        {
+            return offset + size;
+        }
+    };
+
+    std::filesystem::path mPath;
+    std::filesystem::path mPathTemporary;
+    StreamUsageType mStreamUsageType{};
+    bool mDurable{};
+
+    File mFile;
+    std::array<std::unique_ptr<uint8_t[]>, 2> mBuffers{};
+    FileRing mFileRing;
+
+    vector mBuffer;
+
+    // it is read by Sync while another thread writes
+    std::atomic<bool> mFailed{};
+
+    Size::size_max mFileSize{};
+    Size::size_max mReadIndex{};
+
+    // the buffer that is filled/consumed, the other one is in flight
+    size_t mCurrent{};
+    window mWindow{};
+
     vector &&Release() noexcept
     {
         return std::move(mBuffer);
@@ -70,80 +142,324 @@ class StreamFile
     template <typename FunctionSeek> StreamFile &Peek(FunctionSeek &&aFunctionSeek, const Size::size_max aOffset = 0)
     {
         const auto readIndex = mReadIndex;
-        mReadIndex += aOffset;
+        Seek(mReadIndex + aOffset);
         aFunctionSeek(readIndex);
-        mReadIndex = readIndex;
-
-        mStream.seekp(mReadIndex, std::ios_base::beg);
+        Seek(readIndex);
 
         return *this;
     }
 
-    StreamFile &Reserve(const Size::size_max aSize)
+    StreamFile &Reserve(const Size::size_max)
     {
-        mBuffer.reserve(aSize);
-
+        // the file is written through the fixed buffers
         return *this;
     }
 
+    // the span is valid until the next call
     [[nodiscard]] span Read(Size::size_max aSize)
     {
         // clamp read count
-        const auto fileSize = std::filesystem::file_size(mPath);
-        if (mReadIndex + aSize > fileSize)
+        aSize = std::min(aSize, mFileSize - mReadIndex);
+
+        if (mReadIndex + aSize <= mWindow.End())
         {
-            aSize = fileSize - mReadIndex;
+            const auto bytes = GetBuffer(mCurrent).subspan(mReadIndex - mWindow.offset, aSize);
+            mReadIndex += aSize;
+
+            return bytes;
         }
 
-        // TODO: use mapped memory
-        mBuffer.reserve(aSize);
-        mStream.read(mBuffer.data(), aSize);
+        // the bytes are in more buffers so they are gathered
+        mBuffer.resize(aSize);
+        mBuffer.resize(ReadInto(mBuffer));
 
-        mReadIndex += aSize;
         return mBuffer;
     }
 
+    // reads into the bytes without other copies of them when they are bigger than the buffers, returns the count of
+    // the bytes read
+    Size::size_max ReadInto(std::span<uint8_t> aBytes)
+    {
+        aBytes = aBytes.first(std::min<Size::size_max>(aBytes.size(), mFileSize - mReadIndex));
+
+        Size::size_max size{};
+        const auto copy = [&](const Size::size_max aCount) {
+            std::memcpy(aBytes.data() + size, GetBuffer(mCurrent).data() + (mReadIndex - mWindow.offset), aCount);
+
+            size += aCount;
+            mReadIndex += aCount;
+        };
+
+        copy(std::min(aBytes.size(), mWindow.End() - mReadIndex));
+
+        // the big reads go straight from the file into the bytes and the buffers continue after them
+        if (aBytes.size() - size >= BUFFER_SIZE)
+        {
+            const auto count = mFile.ReadAt(aBytes.subspan(size), mReadIndex);
+            if (count < aBytes.size() - size)
+            {
+                mFailed = true;
+            }
+
+            size += count;
+            Seek(mReadIndex + count);
+
+            return size;
+        }
+
+        while (size < aBytes.size())
+        {
+            Next();
+
+            // the file was made smaller while it was read
+            const auto count = std::min(aBytes.size() - size, mWindow.End() - mReadIndex);
+            if (!count)
+            {
+                break;
+            }
+
+            copy(count);
+        }
+
+        return size;
+    }
+
     auto Current()
     {
-        return static_cast<fstream::char_type>(mStream.peek());
+        if (IsEOS())
+        {
+            return uint8_t{};
+        }
+
+        if (mReadIndex == mWindow.End())
+        {
+            Next();
+        }
+
+        return GetBuffer(mCurrent)[mReadIndex - mWindow.offset];
     }
 
     bool IsEOS() const noexcept
     {
-        return mStream.eof();
+        return mReadIndex >= mFileSize;
     }
 
-    StreamFile &Write(const span aSpan)
+    [[nodiscard]] Size::size_max GetSizeLeft() const noexcept
     {
-        mStream.write(aSpan.data(), aSpan.size());
+        return mFileSize - std::min(mReadIndex, mFileSize);
+    }
+
+    StreamFile &Write(span aSpan)
+    {
+        while (!aSpan.empty())
+        {
+            const auto count = std::min<Size::size_max>(aSpan.size(), BUFFER_SIZE - mWindow.size);
+            std::memcpy(GetBuffer(mCurrent).data() + mWindow.size, aSpan.data(), count);
+
+            mWindow.size += count;
+            aSpan = aSpan.subspan(count);
+
+            if (mWindow.size == BUFFER_SIZE)
+            {
+                Flush();
+            }
+        }
 
         return *this;
     }
 
+    // writes the bytes of the file region after the buffered ones, they are moved in the kernel when the files can do
+    // it and read straight into the buffers otherwise, returns the count of the bytes written
+    Size::size_max WriteRegion(File &aFile, const Size::size_max aOffset, const Size::size_max aSize)
+    {
+        if (mWindow.size)
+        {
+            Flush();
+        }
+
+        auto size = aFile.SendTo(mFile, aOffset, mWindow.offset, aSize);
+        mWindow.offset += size;
+
+        while (size < aSize)
+        {
+            const auto buffer = GetBuffer(mCurrent).subspan(mWindow.size);
+            const auto count = aFile.ReadAt(buffer.first(std::min(buffer.size(), aSize - size)), aOffset + size);
+            if (!count)
+            {
+                break;
+            }
+
+            size += count;
+            mWindow.size += count;
+
+            if (mWindow.size == BUFFER_SIZE)
+            {
+                Flush();
+            }
+        }
+
+        return size;
+    }
+
+    // reads the bytes into the file region, they are moved in the kernel when the files can do it and written from
+    // the buffers otherwise, returns the count of the bytes read
+    Size::size_max ReadRegion(File &aFile, const Size::size_max aOffset, Size::size_max aSize)
+    {
+        aSize = std::min(aSize, mFileSize - mReadIndex);
+
+        auto size = mFile.SendTo(aFile, mReadIndex, aOffset, aSize);
+        Seek(mReadIndex + size);
+
+        while (size < aSize)
+        {
+            const auto bytes = Read(std::min(aSize - size, BUFFER_SIZE));
+            if (bytes.empty() || aFile.WriteAt(bytes, aOffset + size) != bytes.size())
+            {
+                break;
+            }
+
+            size += bytes.size();
+        }
+
+        return size;
+    }
+
+    // the buffers are not used so it can be done while writing, it fails when a transfer failed before
+    [[nodiscard]] bool Sync() const noexcept
+    {
+        return mFile.Sync() && !mFailed;
+    }
+
+    [[nodiscard]] bool HasFailed() const noexcept
+    {
+        return mFailed;
+    }
+
+    // writes the buffered bytes and waits for them to be in the file
+    StreamFile &Drain()
+    {
+        if (mStreamUsageType == StreamUsageType::SERIALIZE && mWindow.size)
+        {
+            Flush();
+        }
+
+        // no transfer can be in flight when the file is synced or closed
+        Wait(0);
+        Wait(1);
+
+        return *this;
+    }
+
+    // the durable file replaces the old one unless it is removed or a transfer failed
     StreamFile &Clear(const bool aRemoveFile = false)
     {
-        mStream.close();
+        auto removeFile = aRemoveFile;
+        if (mFile.IsOpen())
+        {
+            Drain();
+
+            const auto synced = mDurable && !aRemoveFile && Sync();
+            mFileRing = {};
+            mFile.Close();
 
-        if (aRemoveFile)
+            if (mDurable)
+            {
+                removeFile = !synced || !File::Replace(mPathTemporary, mPath);
+            }
+        }
+
+        if (removeFile && !mPath.empty())
         {
             std::error_code ec;
-            std::filesystem::remove(mPath);
+            std::filesystem::remove(mDurable ? mPathTemporary : mPath, ec);
         }
 
         mPath.clear();
+        mPathTemporary.clear();
+        mDurable = {};
 
+        mBuffers = {};
         mBuffer.clear();
         mBuffer.shrink_to_fit();
 
+        mFileSize = {};
         mReadIndex = {};
+        mCurrent = {};
+        mWindow = {};
 
         return *this;
     }
 
-  private:
-    std::filesystem::path mPath;
-    fstream mStream;
-    vector mBuffer;
-    Size::size_max mReadIndex{};
+    [[nodiscard]] std::span<uint8_t> GetBuffer(const size_t aBuffer) noexcept
+    {
+        return {mBuffers[aBuffer].get(), mBuffers[aBuffer] ? BUFFER_SIZE : 0};
+    }
+
+    [[nodiscard]] constexpr size_t GetBufferOther() const noexcept
+    {
+        return mCurrent ^ 1;
+    }
+
+    // starts writing the current buffer and continues with the other one when its write ended
+    void Flush()
+    {
+        mFileRing.SubmitWrite(mFile, mCurrent, mWindow.size, mWindow.offset);
+        mFileRing.Flush();
+
+        mCurrent = GetBufferOther();
+        mWindow = {mWindow.End(), 0};
+
+        Wait(mCurrent);
+    }
+
+    // waits for the transfer of the buffer, returns the count of the bytes transferred
+    Size::size_max Wait(const size_t aBuffer)
+    {
+        const auto size = mFileRing.Wait(mFile, aBuffer);
+        if (size < mFileRing.GetSize(aBuffer))
+        {
+            mFailed = true;
+        }
+
+        return size;
+    }
+
+    // starts reading the part of the file at the offset into the buffer (nothing after the end of the file)
+    void Prefetch(const size_t aBuffer, const Size::size_max aOffset)
+    {
+        const auto size = std::min(BUFFER_SIZE, mFileSize - std::min(aOffset, mFileSize));
+        mFileRing.SubmitRead(mFile, aBuffer, size, aOffset);
+    }
+
+    // continues with the buffer read in the background and starts reading the next part of the file in the other one
+    void Next()
+    {
+        mCurrent = GetBufferOther();
+        mWindow = {mWindow.End(), Wait(mCurrent)};
+
+        Prefetch(GetBufferOther(), mWindow.End());
+        mFileRing.Flush();
+    }
+
+    // moves to the index reading the buffers again only when it is not in the current one
+    void Seek(const Size::size_max aIndex)
+    {
+        mReadIndex = std::min(aIndex, mFileSize);
+        if (mWindow.size && mWindow.offset <= mReadIndex && mReadIndex <= mWindow.End())
+        {
+            return;
+        }
+
+        // the transfers in flight must end before their buffers are used again
+        Wait(0);
+        Wait(1);
+
+        mCurrent = {};
+        Prefetch(0, mReadIndex);
+        Prefetch(1, mReadIndex + BUFFER_SIZE);
+        mFileRing.Flush();
+
+        mWindow = {mReadIndex, Wait(0)};
+    }
 };
 } // namespace hbann
@@ -0,0 +1,151 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "Utilities/Size.h"
+
+namespace hbann
+{
+/*
+    The serialized data as a list of spans (like the iovecs of writev/sendmsg) where the big ranges of standard layout
+   objects are referenced in place and everything else is copied into owned chunks, ex.:
+        ::hbann::Stream stream(::hbann::StreamGather{});
+        ::hbann::StreamWriter(stream).WriteAll(message);
+        for (const auto span : stream.Gather())
+        {
+            ...
+        }
+
+    The referenced objects must not change nor be destroyed until the spans are used.
+*/
+class StreamGather
+{
+    friend class Stream;
+
+    using vector = std::vector<uint8_t>;
+    using span = std::span<const uint8_t>;
+
+  public:
+    // the ranges smaller than this are copied
+    static inline constexpr Size::size_max THRESHOLD = 16 * 1024;
+    static inline constexpr Size::size_max CHUNK_SIZE = 16 * 1024;
+
+    explicit StreamGather(const Size::size_max aThreshold = THRESHOLD) noexcept : mThreshold(aThreshold)
+    {
+    }
+
+    [[nodiscard]] constexpr Size::size_max GetThreshold() const noexcept
+    {
+        return mThreshold;
+    }
+
+    // the count of the bytes in the spans
+    [[nodiscard]] constexpr Size::size_max GetSize() const noexcept
+    {
+        return mSize;
+    }
+
+  private:
+    Size::size_max mThreshold{};
+
+    // the chunks never grow over their capacity so the spans in them stay valid
+    std::vector<vector> mChunks{};
+    std::vector<span> mSpans{};
+    Size::size_max mSize{};
+
+    vector mBuffer{};
+
+    [[nodiscard]] const std::vector<span> &Gather() const noexcept
+    {
+        return mSpans;
+    }
+
+    // the spans copied one after another
+    vector &&Release()
+    {
+        mBuffer.clear();
+        mBuffer.reserve(mSize);
+        for (const auto bytes : mSpans)
+        {
+            mBuffer.insert(mBuffer.end(), bytes.begin(), bytes.end());
+        }
+
+        return std::move(mBuffer);
+    }
+
+    StreamGather &Reserve(const Size::size_max)
+    {
+        // the chunks are allocated when they are needed because the size of the referenced ranges is not known
+        return *this;
+    }
+
+    StreamGather &Write(const span aSpan)
+    {
+        if (aSpan.empty())
+        {
+            return *this;
+        }
+
+        if (mChunks.empty() || mChunks.back().capacity() - mChunks.back().size() < aSpan.size())
+        {
+            mChunks.emplace_back().reserve(std::max(CHUNK_SIZE, aSpan.size()));
+        }
+
+        auto &chunk = mChunks.back();
+        const auto data = chunk.data() + chunk.size();
+        chunk.insert(chunk.end(), aSpan.begin(), aSpan.end());
+
+        // the bytes copied after the last span continue it
+        if (!mSpans.empty() && mSpans.back().data() + mSpans.back().size() == data)
+        {
+            mSpans.back() = {mSpans.back().data(), mSpans.back().size() + aSpan.size()};
+        }
+        else
+        {
+            mSpans.emplace_back(data, aSpan.size());
+        }
+
+        mSize += aSpan.size();
+        return *this;
+    }
+
+    // references the bytes when they are not smaller than the threshold, the bytes must outlive the spans
+    StreamGather &WriteReference(const span aSpan)
+    {
+        if (aSpan.size() < mThreshold)
+        {
+            return Write(aSpan);
+        }
+
+        mSpans.push_back(aSpan);
+        mSize += aSpan.size();
+
+        return *this;
+    }
+
+    // continues with the spans of the other one taking its chunks
+    StreamGather &Append(StreamGather &&aStreamGather)
+    {
+        std::ranges::move(aStreamGather.mChunks, std::back_inserter(mChunks));
+        mSpans.insert(mSpans.end(), aStreamGather.mSpans.begin(), aStreamGather.mSpans.end());
+        mSize += aStreamGather.mSize;
+
+        aStreamGather.Clear();
+        return *this;
+    }
+
+    StreamGather &Clear()
+    {
+        mChunks = {};
+        mSpans = {};
+        mSize = {};
+        mBuffer = {};
+
+        return *this;
+    }
+};
+} // namespace hbann
@@ -7,36 +7,61 @@
 #pragma once
 
 #include "Stream.h"
+#include "Utilities/ByteSwapper.h"
 #include "Utilities/Converter.h"
+#include "Utilities/Reflector.h"
 #include "Utilities/SizeFinder.h"
+#include "Utilities/SizeFixed.h"
+#include "Utilities/SizeVarint.h"
 
 namespace hbann
 {
-class StreamReader
+// The size policy and the endianness must be the ones the data was written with, see BasicStreamWriter
+template <typename SizeType, std::endian vEndian> class BasicStreamReader
 {
+    friend class Attribute;
+    friend class StaticStreamable;
+    template <typename, std::endian> friend class BasicIndexedReader;
+    template <typename, std::endian> friend class BasicRecordReader;
+
   public:
-    constexpr explicit StreamReader(Stream &aStream) noexcept : mStream(&aStream)
+    constexpr explicit BasicStreamReader(Stream &aStream) noexcept : mStream(&aStream)
     {
     }
 
-    constexpr StreamReader(const StreamReader &aStreamReader) noexcept : mStream(aStreamReader.mStream)
+    constexpr BasicStreamReader(const BasicStreamReader &aStreamReader) noexcept : mStream(aStreamReader.mStream)
     {
     }
 
-    constexpr StreamReader(StreamReader &&aStreamReader) noexcept
+    constexpr BasicStreamReader(BasicStreamReader &&aStreamReader) noexcept
     {
         *this = std::move(aStreamReader);
     }
 
-    template <typename Type, typename... Types> constexpr decltype(auto) ReadAll(Type &aObject, Types &...aObjects)
+    // the objects are forwarded so the field attributes can be passed as temporaries
+    template <typename Type, typename... Types> constexpr decltype(auto) ReadAll(Type &&aObject, Types &&...aObjects)
     {
         using TypeRaw = std::remove_cvref_t<Type>;
 
-        Read<TypeRaw>(aObject);
+        // the leading objects of known size were written with a single write
+        constexpr auto count = SizeFinder::FindObjectsOfKnownSizeCount<Type, Types...>();
+        if constexpr (count > 1)
+        {
+            auto objects = std::forward_as_tuple(aObject, aObjects...);
+            ReadObjectsOfKnownSize(objects, std::make_index_sequence<count>{});
 
-        if constexpr (sizeof...(aObjects))
+            [&]<size_t... vIndexes>(std::index_sequence<vIndexes...>) {
+                ReadAll(std::get<count + vIndexes>(objects)...);
+            }(std::make_index_sequence<sizeof...(Types) + 1 - count>{});
+        }
+        else
         {
-            ReadAll<Types...>(aObjects...);
+            Read<TypeRaw>(aObject);
+
+            if constexpr (sizeof...(aObjects))
+            {
+                ReadAll(aObjects...);
+            }
         }
 
         return *this;
@@ -54,20 +79,26 @@ class StreamReader
         return *this;
     }
 
-    constexpr StreamReader &operator=(const StreamReader &aStreamReader) noexcept
+    constexpr BasicStreamReader &operator=(const BasicStreamReader &aStreamReader) noexcept
     {
         mStream = aStreamReader.mStream;
         return *this;
     }
 
-    constexpr StreamReader &operator=(StreamReader &&aStreamReader) noexcept
+    constexpr BasicStreamReader &operator=(BasicStreamReader &&aStreamReader) noexcept
     {
         mStream = aStreamReader.mStream;
         return *this;
     }
 
   private:
+    static inline constexpr auto IS_ENDIAN_NATIVE = vEndian == std::endian::native;
+
+    // the strings read inside a Dictionary attribute in the order they were written
+    using strings = std::vector<std::string>;
+
     Stream *mStream{};
+    strings *mStrings{};
 
     template <typename Type> constexpr decltype(auto) Read(Type &aObject)
     {
@@ -77,7 +108,12 @@ class StreamReader
             return *this;
         }
 
-        if constexpr (is_optional_v<Type>)
+        if constexpr (is_attribute<Type>)
+        {
+            aObject.FromStream(*this);
+            return *this;
+        }
+        else if constexpr (is_optional_v<Type>)
         {
             return ReadOptional(aObject);
         }
@@ -105,10 +141,19 @@ class StreamReader
         {
             return ReadStreamable(aObject);
         }
+        else if constexpr (is_static_streamable<Type>)
+        {
+            return ReadStaticStreamable(aObject);
+        }
         else if constexpr (is_any_pointer<Type>)
         {
             return ReadPointer(aObject);
         }
+        else if constexpr (is_reflectable_aggregate<Type>)
+        {
+            Reflector::Apply(aObject, [&](auto &&...aFields) { ReadAll(aFields...); });
+            return *this;
+        }
         else if constexpr (is_standard_layout_no_pointer<Type>)
         {
             return ReadObjectOfKnownSize(aObject);
@@ -183,6 +228,30 @@ class StreamReader
         return *this;
     }
 
+    template <typename Type> constexpr decltype(auto) ReadStaticStreamable(Type &aStreamable)
+    {
+        static_assert(is_static_streamable<Type>, "Type is not a static streamable!");
+
+        auto stream = static_cast<Stream>(mStream->Read(ReadCount())); // read static streamable size in bytes
+        BasicStreamReader(stream).ReadStaticStreamableFields(aStreamable);
+
+        return *this;
+    }
+
+    // the fields of the bases and then the fields of the static streamable, everything known at compile time
+    template <typename Type> constexpr decltype(auto) ReadStaticStreamableFields(Type &aStreamable)
+    {
+        if constexpr (requires { typename Type::streamable_bases; })
+        {
+            [&]<typename... Bases>(std::type_identity<std::tuple<Bases...>>) {
+                (ReadStaticStreamableFields(static_cast<Bases &>(aStreamable)), ...);
+            }(std::type_identity<typename Type::streamable_bases>{});
+        }
+
+        aStreamable.StreamableApply([&](auto &&...aFields) { ReadAll(aFields...); });
+        return *this;
+    }
+
     template <typename Type> constexpr decltype(auto) ReadStreamablePtr(Type &aStreamablePtr)
     {
         static_assert(is_derived_from_pointer<Type, IStreamable>, "Type is not a streamable smart/raw pointer!");
@@ -217,20 +286,49 @@ class StreamReader
         return *this;
     }
 
+    // reads the index + 1 of an already read string or 0 followed by a new string that is moved into the strings
+    [[nodiscard]] inline std::string ReadStringReference()
+    {
+        if (const auto index = ReadCount(); index)
+        {
+            const auto indexString = index - 1;
+            if (indexString >= mStrings->size())
+            {
+                throw std::out_of_range("Out of bounds string reference!");
+            }
+
+            return (*mStrings)[indexString];
+        }
+
+        auto &string = mStrings->emplace_back();
+        ReadRangeRank1(string, ReadCount());
+
+        return string;
+    }
+
     template <typename Type> [[nodiscard]] constexpr Type ReadRange()
     {
         static_assert(std::ranges::range<Type>, "Type is not a range!");
 
         using TypeValueType = typename Type::value_type;
 
+        if constexpr (std::is_same_v<Type, std::string>)
+        {
+            if (mStrings)
+            {
+                return ReadStringReference();
+            }
+        }
+
         Type range{};
         const auto count = ReadCount();
 
-        if constexpr (SizeFinder::FindRangeRank<Type>() > 1)
+        // the ranges of arrays of known size were written as one block like the rank 1 ranges
+        if constexpr (SizeFinder::FindRangeRank<Type>() > 1 && !is_range_of_arrays_of_known_size<Type>)
         {
             for (size_t i = 0; i < count; i++)
             {
-                range.insert(std::ranges::cend(range), ReadRange<TypeValueType>());
+                Insert(range, i, ReadRange<TypeValueType>());
             }
         }
         else
@@ -254,7 +352,8 @@ class StreamReader
         return *this;
     }
 
-    template <typename Type> constexpr StreamReader &ReadRangeStandardLayout(Type &aRange, const Size::size_max aCount)
+    template <typename Type>
+    constexpr BasicStreamReader &ReadRangeStandardLayout(Type &aRange, const Size::size_max aCount)
     {
         static_assert(is_range_standard_layout<Type>, "Type is not a standard layout range!");
 
@@ -268,6 +367,12 @@ class StreamReader
         if constexpr (is_utf16string<Type>)
         {
             aRange.assign(Converter::Decode<Type>(mStream->Read(aCount)));
+
+            // the code units were written as bytes
+            if constexpr (!Converter::IS_ENCODING_UTF8 && !IS_ENDIAN_NATIVE)
+            {
+                ByteSwapper::Swap(std::span<TypeValueType>(aRange));
+            }
         }
         else if constexpr (is_path<Type>)
         {
@@ -275,14 +380,111 @@ class StreamReader
         }
         else
         {
-            const auto rangeView = mStream->Read(aCount * sizeof(TypeValueType));
-            const auto rangePtr = reinterpret_cast<const TypeValueType *>(rangeView.data());
-            aRange.assign(rangePtr, rangePtr + rangeView.size() / sizeof(TypeValueType));
+            // the count of a corrupted stream can't make the size of the bytes overflow
+            const auto count = std::min(aCount, std::numeric_limits<Size::size_max>::max() / sizeof(TypeValueType));
+
+            // the big ranges of the files/descriptors are read into their memory without copies through the buffers
+            if (const auto bufferSize = mStream->GetBufferSize();
+                bufferSize && count * sizeof(TypeValueType) >= bufferSize)
+            {
+                ReadRangeStandardLayoutInto(aRange, count);
+            }
+            else if constexpr (is_array_v<Type>)
+            {
+                const auto rangeView = mStream->Read(count * sizeof(TypeValueType));
+                std::memcpy(aRange.data(), rangeView.data(), std::min(rangeView.size(), sizeof(aRange)));
+            }
+            else
+            {
+                const auto rangeView = mStream->Read(count * sizeof(TypeValueType));
+                const auto rangePtr = reinterpret_cast<const TypeValueType *>(rangeView.data());
+                aRange.assign(rangePtr, rangePtr + rangeView.size() / sizeof(TypeValueType));
+            }
+
+            // the arrays were written as the elements of the innermost one
+            using TypeLeaf = array_leaf_t<TypeValueType>;
+            if constexpr (!IS_ENDIAN_NATIVE && is_byte_swappable<TypeLeaf> && sizeof(TypeLeaf) > 1)
+            {
+                const auto leafs = reinterpret_cast<TypeLeaf *>(std::ranges::data(aRange));
+                ByteSwapper::Swap(std::span<TypeLeaf>(leafs, aRange.size() * sizeof(TypeValueType) / sizeof(TypeLeaf)));
+            }
         }
 
         return *this;
     }
 
+    template <typename Type> void ReadRangeStandardLayoutInto(Type &aRange, const Size::size_max aCount)
+    {
+        using TypeValueType = typename Type::value_type;
+
+        const auto asBytes = [](TypeValueType *aData, const Size::size_max aSize) {
+            return std::span(reinterpret_cast<uint8_t *>(aData), aSize * sizeof(TypeValueType));
+        };
+
+        if constexpr (is_array_v<Type>)
+        {
+            // the extra elements are dropped
+            const auto count = std::min<Size::size_max>(aCount, aRange.size());
+            mStream->ReadInto(asBytes(aRange.data(), count));
+            (void)mStream->Read((aCount - count) * sizeof(TypeValueType));
+        }
+        else
+        {
+            // the count can't be trusted (ex.: a corrupted file) so no more is allocated than the bytes left and the
+            // streams that don't know them (ex.: a pipe) grow the range while it is read
+            const auto sizeLeft = mStream->GetSizeLeft();
+            const auto count = std::min(aCount, sizeLeft / sizeof(TypeValueType));
+            const auto countFirst = sizeLeft != std::numeric_limits<Size::size_max>::max()
+                                        ? count
+                                        : std::max<Size::size_max>(mStream->GetBufferSize() / sizeof(TypeValueType), 1);
+
+            Size::size_max size{};
+            while (size < count)
+            {
+                const auto countChunk = std::min(count - size, std::max(size, countFirst));
+                const auto countRead = ReadRangeStandardLayoutChunk(aRange, size, countChunk);
+
+                size += countRead;
+                if (countRead < countChunk)
+                {
+                    break;
+                }
+            }
+
+            aRange.resize(size);
+        }
+    }
+
+    // reads the count of elements after the first ones into the range, returns the count of the elements read
+    template <typename Type>
+    Size::size_max ReadRangeStandardLayoutChunk(Type &aRange, const Size::size_max aIndex, const Size::size_max aCount)
+    {
+        using TypeValueType = typename Type::value_type;
+
+        Size::size_max countRead{};
+        const auto readInto = [&](TypeValueType *aData) {
+            const std::span bytes(reinterpret_cast<uint8_t *>(aData + aIndex), aCount * sizeof(TypeValueType));
+            countRead = mStream->ReadInto(bytes) / sizeof(TypeValueType);
+
+            return aIndex + countRead;
+        };
+
+#ifdef __cpp_lib_string_resize_and_overwrite
+        if constexpr (is_basic_string_v<Type>)
+        {
+            // the strings are not filled with zeros before they are read
+            aRange.resize_and_overwrite(aIndex + aCount, [&](TypeValueType *aData, const size_t) {
+                return readInto(aData);
+            });
+
+            return countRead;
+        }
+#endif // __cpp_lib_string_resize_and_overwrite
+
+        aRange.resize(aIndex + aCount);
+        return readInto(aRange.data()) - aIndex;
+    }
+
     template <typename Type> constexpr decltype(auto) ReadRangeRank1(Type &aRange, const Size::size_max aCount)
     {
         static_assert(std::ranges::range<Type>, "Type is not a range!");
@@ -299,13 +501,61 @@ class StreamReader
             {
                 TypeValueType object{};
                 Read(object);
-                aRange.insert(std::ranges::cend(aRange), std::move(object));
+                Insert(aRange, i, std::move(object));
+            }
+        }
+
+        return *this;
+    }
+
+    // the std::arrays can't grow so we assign their elements (the extra ones are dropped)
+    template <typename Type, typename TypeValue>
+    constexpr void Insert(Type &aRange, const Size::size_max aIndex, TypeValue &&aValue)
+    {
+        if constexpr (is_array_v<Type>)
+        {
+            if (aIndex < aRange.size())
+            {
+                aRange[aIndex] = std::forward<TypeValue>(aValue);
             }
         }
+        else
+        {
+            aRange.insert(std::ranges::cend(aRange), std::forward<TypeValue>(aValue));
+        }
+    }
+
+    template <typename Tuple, size_t... vIndexes>
+    constexpr decltype(auto) ReadObjectsOfKnownSize(Tuple &aObjects, std::index_sequence<vIndexes...>)
+    {
+        using TypeObjects = std::tuple<std::remove_cvref_t<std::tuple_element_t<vIndexes, Tuple>>...>;
+
+        constexpr auto offsets = SizeFinder::FindObjectsOfKnownSizeOffsets<TypeObjects>();
+
+        // for backwards compatibility we read only the objects that were written
+        const auto view = mStream->Read(offsets.back());
+        (CopyObjectOfKnownSize(std::get<vIndexes>(aObjects), view, offsets[vIndexes]), ...);
 
         return *this;
     }
 
+    template <typename Type>
+    constexpr void CopyObjectOfKnownSize(Type &aObject, const std::span<const uint8_t> aView,
+                                         const Size::size_max aOffset) noexcept
+    {
+        if (aOffset + sizeof(Type) > aView.size())
+        {
+            return;
+        }
+
+        std::memcpy(&aObject, aView.data() + aOffset, sizeof(Type));
+
+        if constexpr (!IS_ENDIAN_NATIVE && is_byte_swappable<Type>)
+        {
+            aObject = ByteSwapper::Swap(aObject);
+        }
+    }
+
     template <typename Type> constexpr decltype(auto) ReadObjectOfKnownSize(Type &aObject)
     {
         static_assert(is_standard_layout_no_pointer<Type>, "Type is not an object of known size or it is a pointer!");
@@ -313,13 +563,38 @@ class StreamReader
         const auto view = mStream->Read(sizeof(Type));
         aObject = *reinterpret_cast<const Type *>(view.data());
 
+        if constexpr (!IS_ENDIAN_NATIVE && is_byte_swappable<Type>)
+        {
+            aObject = ByteSwapper::Swap(aObject);
+        }
+
         return *this;
     }
 
     inline Size::size_max ReadCount() noexcept
     {
-        const auto size = Size::FindRequiredBytes(mStream->Current());
-        return Size::MakeSize(mStream->Read(size));
+        if constexpr (SizeType::BYTES_FIXED)
+        {
+            return SizeType::MakeSize(mStream->Read(SizeType::BYTES_FIXED));
+        }
+        else
+        {
+            // we copy the first byte because the next read may reuse the memory of the file streams
+            const auto first = mStream->Read(1);
+            if (first.empty())
+            {
+                return 0;
+            }
+
+            const auto firstByte = first.front();
+            const auto requiredBytes = SizeType::FindRequiredBytes(firstByte);
+            if (requiredBytes <= 1)
+            {
+                return SizeType::MakeSize(firstByte, {});
+            }
+
+            return SizeType::MakeSize(firstByte, mStream->Read(requiredBytes - 1));
+        }
     }
 };
 } // namespace hbann
@@ -7,36 +7,70 @@
 #pragma once
 
 #include "Stream.h"
+#include "Utilities/ByteSwapper.h"
 #include "Utilities/Converter.h"
+#include "Utilities/Reflector.h"
 #include "Utilities/SizeFinder.h"
+#include "Utilities/SizeFixed.h"
+#include "Utilities/SizeVarint.h"
 
 namespace hbann
 {
-class StreamWriter
+/*
+    The size policy (Size, SizeFixed or SizeVarint) decides how every count and size is written.
+
+    The endianness decides the byte order of the arithmetic/enum values and of the ranges of them, it is free when it
+   is the native one and it costs a vectorized byte swap otherwise. Other standard layout objects are written as they
+   are in memory.
+*/
+template <typename SizeType, std::endian vEndian> class BasicStreamWriter
 {
+    friend class Attribute;
+    friend class StaticStreamable;
+    template <typename, std::endian> friend class BasicRecordWriter;
+
   public:
-    constexpr explicit StreamWriter(Stream &aStream) noexcept : mStream(&aStream)
+    constexpr explicit BasicStreamWriter(Stream &aStream) noexcept : mStream(&aStream)
     {
     }
 
-    constexpr StreamWriter(const StreamWriter &aStreamWriter) noexcept : mStream(aStreamWriter.mStream)
+    constexpr BasicStreamWriter(const BasicStreamWriter &aStreamWriter) noexcept : mStream(aStreamWriter.mStream)
     {
     }
 
-    constexpr StreamWriter(StreamWriter &&aStreamWriter) noexcept
+    constexpr BasicStreamWriter(BasicStreamWriter &&aStreamWriter) noexcept
     {
         *this = std::move(aStreamWriter);
     }
 
-    template <typename Type, typename... Types> constexpr void WriteAll(Type &aObject, Types &...aObjects)
+    // the objects are forwarded so the field attributes can be passed as temporaries
+    template <typename Type, typename... Types> constexpr void WriteAll(Type &&aObject, Types &&...aObjects)
     {
         using TypeRaw = std::remove_cvref_t<Type>;
 
-        Write<TypeRaw>(aObject);
+        // the leading objects of known size are written with a single write
+        constexpr auto count = SizeFinder::FindObjectsOfKnownSizeCount<Type, Types...>();
+        if constexpr (count > 1)
+        {
+            auto objects = std::forward_as_tuple(std::forward<Type>(aObject), std::forward<Types>(aObjects)...);
+            WriteObjectsOfKnownSize(objects, std::make_index_sequence<count>{});
 
-        if constexpr (sizeof...(aObjects))
+            [&]<size_t... vIndexes>(std::index_sequence<vIndexes...>) {
+                WriteAll(std::get<count + vIndexes>(std::move(objects))...);
+            }(std::make_index_sequence<sizeof...(Types) + 1 - count>{});
+        }
+        else
         {
-            WriteAll<Types...>(aObjects...);
+            // the temporaries can't be referenced by a gather
+            const auto referable = mReferable;
+            mReferable &= std::is_lvalue_reference_v<Type>;
+            Write<TypeRaw>(aObject);
+            mReferable = referable;
+
+            if constexpr (sizeof...(aObjects))
+            {
+                WriteAll(std::forward<Types>(aObjects)...);
+            }
         }
     }
 
@@ -44,34 +78,122 @@ class StreamWriter
     {
     }
 
-    constexpr StreamWriter &operator=(const StreamWriter &aStreamWriter) noexcept
+    constexpr BasicStreamWriter &operator=(const BasicStreamWriter &aStreamWriter) noexcept
     {
         mStream = aStreamWriter.mStream;
         return *this;
     }
 
-    constexpr StreamWriter &operator=(StreamWriter &&aStreamWriter) noexcept
+    constexpr BasicStreamWriter &operator=(BasicStreamWriter &&aStreamWriter) noexcept
     {
         mStream = aStreamWriter.mStream;
         return *this;
     }
 
   private:
+    static inline constexpr auto IS_ENDIAN_NATIVE = vEndian == std::endian::native;
+    static inline constexpr Size::size_max SWAP_BUFFER_BYTES = 4096;
+
+    // the strings written inside a Dictionary attribute and their indices
+    using strings = std::unordered_map<std::string_view, Size::size_max>;
+
     Stream *mStream{};
+    strings *mStrings{};
+
+    // the ranges can be referenced when the stream is a gather (see StreamGather)
+    bool mReferable = true;
 
     template <typename Type> constexpr decltype(auto) WriteObjectOfKnownSize(Type &aObject)
     {
         static_assert(is_standard_layout_no_pointer<Type>, "Type is not an object of known size or it is a pointer!");
 
-        const auto objectPtr = reinterpret_cast<uint8_t *>(&aObject);
-        mStream->Write({objectPtr, sizeof(aObject)});
+        if constexpr (!IS_ENDIAN_NATIVE && is_byte_swappable<Type>)
+        {
+            const auto object = ByteSwapper::Swap(aObject);
+            mStream->Write({reinterpret_cast<const uint8_t *>(&object), sizeof(object)});
+        }
+        else if (mReferable)
+        {
+            // the big objects (ex.: a matrix in a struct) are referenced by a gather like the big ranges
+            mStream->WriteReference({reinterpret_cast<const uint8_t *>(&aObject), sizeof(aObject)});
+        }
+        else
+        {
+            const auto objectPtr = reinterpret_cast<uint8_t *>(&aObject);
+            mStream->Write({objectPtr, sizeof(aObject)});
+        }
+
+        return *this;
+    }
+
+    template <typename Tuple, size_t... vIndexes>
+    constexpr decltype(auto) WriteObjectsOfKnownSize(Tuple &aObjects, std::index_sequence<vIndexes...>)
+    {
+        using TypeObjects = std::tuple<std::remove_cvref_t<std::tuple_element_t<vIndexes, Tuple>>...>;
+
+        constexpr auto offsets = SizeFinder::FindObjectsOfKnownSizeOffsets<TypeObjects>();
+        constexpr auto size = offsets.back();
+
+        static_assert(size <= SizeFinder::OBJECTS_OF_KNOWN_SIZE_MAX, "The objects are too big for the stack!");
+
+        std::array<uint8_t, size> buffer;
+        (CopyObjectOfKnownSize(buffer.data() + offsets[vIndexes], std::get<vIndexes>(aObjects)), ...);
+        mStream->Write(buffer);
+
+        return *this;
+    }
+
+    template <typename Type> static constexpr void CopyObjectOfKnownSize(uint8_t *aBuffer, const Type &aObject) noexcept
+    {
+        if constexpr (!IS_ENDIAN_NATIVE && is_byte_swappable<Type>)
+        {
+            const auto object = ByteSwapper::Swap(aObject);
+            std::memcpy(aBuffer, &object, sizeof(object));
+        }
+        else
+        {
+            std::memcpy(aBuffer, &aObject, sizeof(aObject));
+        }
+    }
+
+    template <typename Type>
+    constexpr decltype(auto) WriteElements(const std::span<const Type> aElements, const bool aReferable = false)
+    {
+        if constexpr (is_array_v<Type>)
+        {
+            // the arrays are written as the elements of the innermost one so they can be swapped
+            using TypeLeaf = array_leaf_t<Type>;
+            static_assert(sizeof(Type) % sizeof(TypeLeaf) == 0, "Type has padding between the elements!");
+
+            const auto leafs = reinterpret_cast<const TypeLeaf *>(aElements.data());
+            WriteElements(std::span<const TypeLeaf>(leafs, aElements.size_bytes() / sizeof(TypeLeaf)), aReferable);
+        }
+        else if constexpr (!IS_ENDIAN_NATIVE && is_byte_swappable<Type> && sizeof(Type) > 1)
+        {
+            // we swap chunks on the stack so big ranges don't need another allocation
+            Type buffer[SWAP_BUFFER_BYTES / sizeof(Type)];
+            for (Size::size_max i = 0; i < aElements.size(); i += std::size(buffer))
+            {
+                const auto count = std::min(std::size(buffer), aElements.size() - i);
+                ByteSwapper::Swap(aElements.subspan(i, count), std::span<Type>(buffer, count));
+                mStream->Write({reinterpret_cast<const uint8_t *>(buffer), count * sizeof(Type)});
+            }
+        }
+        else if (aReferable)
+        {
+            mStream->WriteReference({reinterpret_cast<const uint8_t *>(aElements.data()), aElements.size_bytes()});
+        }
+        else
+        {
+            mStream->Write({reinterpret_cast<const uint8_t *>(aElements.data()), aElements.size_bytes()});
+        }
 
         return *this;
     }
 
     inline decltype(auto) WriteCount(const Size::size_max aSize)
     {
-        mStream->Write(Size::MakeSize(aSize));
+        mStream->Write(SizeType::MakeSize(aSize));
         return *this;
     }
 
@@ -79,6 +201,20 @@ class StreamWriter
     {
         static_assert(std::derived_from<Type, IStreamable>, "Type is not a streamable!");
 
+        // the fields of the streamable are gathered too so its big ranges are still referenced
+        if (mStream->IsStreamGather() && mReferable)
+        {
+            auto stream(std::move(aStreamable.SerializeGather(mStream->GetStreamGather().GetThreshold())));
+
+            WriteCount(stream.GetStreamGather().GetSize());
+            return mStream->Append(std::move(stream));
+        }
+
+        if (mStream->IsBuffer())
+        {
+            return WriteStreamableBuffer(aStreamable);
+        }
+
         auto stream(std::move(aStreamable.Serialize()));
         const auto streamView = stream.View();
 
@@ -87,11 +223,130 @@ class StreamWriter
         return mStream->Write(streamView);
     }
 
+    template <typename Type> constexpr decltype(auto) WriteStreamableBuffer(Type &aStreamable)
+    {
+        return WriteBuffer([&](const std::span<uint8_t> aBytes) { return aStreamable.Serialize(aBytes); });
+    }
+
+    // the bytes are serialized into the rest of the buffer after the room of the smallest size so nothing is
+    // allocated, they are moved after the size when it needs more room
+    template <typename FunctionSerialize> constexpr decltype(auto) WriteBuffer(FunctionSerialize &&aSerialize)
+    {
+        auto &streamBuffer = mStream->GetBuffer();
+        const auto offset = streamBuffer.size + SizeType::FindRequiredBytes(Size::size_max{});
+        const auto bytes = streamBuffer.data.subspan(std::min(offset, streamBuffer.data.size()));
+
+        const std::optional<Size::size_max> size = aSerialize(bytes);
+        const auto offsetAfterCount = streamBuffer.size + SizeType::FindRequiredBytes(size.value_or(0));
+        if (!size || *size > streamBuffer.data.size() - std::min(offsetAfterCount, streamBuffer.data.size()))
+        {
+            streamBuffer.overflowed = true;
+            return *mStream;
+        }
+
+        std::memmove(streamBuffer.data.data() + offsetAfterCount, bytes.data(), *size);
+
+        WriteCount(*size);
+        return mStream->Write(streamBuffer.data.subspan(offsetAfterCount, *size));
+    }
+
+    template <typename Type> constexpr decltype(auto) WriteStaticStreamable(Type &aStreamable)
+    {
+        static_assert(is_static_streamable<Type>, "Type is not a static streamable!");
+
+        // we write the size in bytes of the fields like for the streamables, before them when it is known
+        if constexpr (constexpr auto size = SizeFinder::FindSerializedSize<Type, SizeType>(); size.exact)
+        {
+            WriteCount(size.max);
+
+            BasicStreamWriter streamWriter(*mStream);
+            streamWriter.mReferable = mReferable;
+            streamWriter.WriteStaticStreamableFields(aStreamable);
+
+            return *mStream;
+        }
+        else
+        {
+            if (mStream->IsBuffer())
+            {
+                return WriteBuffer([&](const std::span<uint8_t> aBytes) {
+                    Stream stream(aBytes);
+                    BasicStreamWriter(stream).WriteStaticStreamableFields(aStreamable);
+
+                    return stream.HasFailed() ? std::nullopt : std::optional(stream.View().size());
+                });
+            }
+
+            // the bytes of the checksum must be in order
+            if (mStream->IsStream() && !mStream->mChecksum)
+            {
+                return WriteStaticStreamableStream(aStreamable);
+            }
+
+            Stream stream;
+            BasicStreamWriter(stream).WriteStaticStreamableFields(aStreamable);
+            const auto streamView = stream.View();
+
+            WriteCount(streamView.size());
+            return mStream->Write(streamView);
+        }
+    }
+
+    // the fields are written after the room of the smallest size and the size is written in place when they are done,
+    // they are moved after the size when it needs more room
+    template <typename Type> constexpr decltype(auto) WriteStaticStreamableStream(Type &aStreamable)
+    {
+        auto &stream = mStream->GetStream();
+        const auto offset = stream.size();
+        const auto countSize = SizeType::FindRequiredBytes(Size::size_max{});
+        stream.resize(offset + countSize);
+
+        BasicStreamWriter(*mStream).WriteStaticStreamableFields(aStreamable);
+
+        const auto count = SizeType::MakeSize(stream.size() - offset - countSize);
+        stream.insert(stream.begin() + offset + countSize, count.count - countSize, 0);
+        std::ranges::copy(std::span<const uint8_t>(count), stream.begin() + offset);
+
+        return *mStream;
+    }
+
+    // the fields of the bases and then the fields of the static streamable, everything known at compile time
+    template <typename Type> constexpr decltype(auto) WriteStaticStreamableFields(Type &aStreamable)
+    {
+        if constexpr (requires { typename Type::streamable_bases; })
+        {
+            [&]<typename... Bases>(std::type_identity<std::tuple<Bases...>>) {
+                (WriteStaticStreamableFields(static_cast<Bases &>(aStreamable)), ...);
+            }(std::type_identity<typename Type::streamable_bases>{});
+        }
+
+        aStreamable.StreamableApply([&](auto &&...aFields) { WriteAll(aFields...); });
+        return *this;
+    }
+
+    // writes the index + 1 of an already written string or 0 and remembers it when it is new
+    inline bool WriteStringReference(const std::string &aString)
+    {
+        const auto [it, inserted] = mStrings->try_emplace(aString, mStrings->size());
+        WriteCount(inserted ? 0 : it->second + 1);
+
+        return !inserted;
+    }
+
     template <typename Type> constexpr decltype(auto) WriteRange(Type &aRange)
     {
         static_assert(std::ranges::range<Type>, "Type is not a range!");
 
-        if constexpr (SizeFinder::FindRangeRank<Type>() > 1)
+        if constexpr (std::is_same_v<Type, std::string>)
+        {
+            if (mStrings && WriteStringReference(aRange))
+            {
+                return *this;
+            }
+        }
+
+        // the ranges of arrays of known size are written as one block like the rank 1 ranges
+        if constexpr (SizeFinder::FindRangeRank<Type>() > 1 && !is_range_of_arrays_of_known_size<Type>)
         {
             WriteCount(SizeFinder::GetRangeCount(aRange));
             for (auto &object : aRange)
@@ -107,27 +362,32 @@ class StreamWriter
         return *this;
     }
 
-    template <typename Type> constexpr decltype(auto) WriteRangeStandardLayout(const Type &aRange)
+    template <typename Type>
+    constexpr decltype(auto) WriteRangeStandardLayout(const Type &aRange, const bool aReferable = true)
     {
         static_assert(is_range_standard_layout<Type>, "Type is not a standard layout range!");
 
         using TypeValueType = typename Type::value_type;
 
-        if constexpr (is_utf16string<Type>)
+        if constexpr (is_utf16string<Type> && !Converter::IS_ENCODING_UTF8 && !IS_ENDIAN_NATIVE)
         {
-            WriteRangeStandardLayout(Converter::Encode(aRange));
+            // the code units are written as bytes so we must order them ourselves
+            WriteCount(SizeFinder::GetRangeCount(aRange) * sizeof(TypeValueType));
+            WriteElements(std::span<const TypeValueType>(aRange));
+        }
+        else if constexpr (is_utf16string<Type>)
+        {
+            WriteRangeStandardLayout(Converter::Encode(aRange), false);
         }
         else if constexpr (is_path<Type>)
         {
-            WriteRangeStandardLayout(aRange.native());
+            WriteRangeStandardLayout(aRange.native(), aReferable);
         }
         else
         {
             WriteCount(SizeFinder::GetRangeCount(aRange));
-
-            const auto rangePtr = reinterpret_cast<const uint8_t *>(std::ranges::data(aRange));
-            const auto rangeSize = SizeFinder::GetRangeCount(aRange) * sizeof(TypeValueType);
-            mStream->Write({rangePtr, rangeSize});
+            WriteElements(std::span<const TypeValueType>(std::ranges::data(aRange), SizeFinder::GetRangeCount(aRange)),
+                          aReferable && mReferable);
         }
 
         return *this;
@@ -135,7 +395,8 @@ class StreamWriter
 
     template <typename Type> constexpr decltype(auto) WriteRangeRank1(Type &aRange)
     {
-        static_assert(SizeFinder::FindRangeRank<Type>() == 1, "Type is not a rank 1 range!");
+        static_assert(SizeFinder::FindRangeRank<Type>() == 1 || is_range_of_arrays_of_known_size<Type>,
+                      "Type is not a rank 1 range or a range of arrays of known size!");
 
         if constexpr (is_range_standard_layout<Type>)
         {
@@ -178,7 +439,12 @@ class StreamWriter
 
     template <typename Type> constexpr decltype(auto) Write(Type &aObject)
     {
-        if constexpr (is_optional_v<Type>)
+        if constexpr (is_attribute<Type>)
+        {
+            aObject.ToStream(*this);
+            return *this;
+        }
+        else if constexpr (is_optional_v<Type>)
         {
             return WriteOptional(aObject);
         }
@@ -205,10 +471,19 @@ class StreamWriter
         {
             return WriteStreamable(aObject);
         }
+        else if constexpr (is_static_streamable<Type>)
+        {
+            return WriteStaticStreamable(aObject);
+        }
         else if constexpr (is_any_pointer<Type>)
         {
             return Write(*aObject);
         }
+        else if constexpr (is_reflectable_aggregate<Type>)
+        {
+            Reflector::Apply(aObject, [&](auto &&...aFields) { WriteAll(aFields...); });
+            return *this;
+        }
         else if constexpr (is_standard_layout_no_pointer<Type>)
         {
             return WriteObjectOfKnownSize(aObject);
@@ -0,0 +1,96 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+namespace hbann
+{
+/*
+    Reads values of 1-64 bits packed by a BitWriter.
+
+    The bytes are loaded 8 at a time into a 64 bits cache, reading past the end yields zero bits.
+*/
+class BitReader
+{
+    using span = std::span<const uint8_t>;
+
+  public:
+    constexpr explicit BitReader(const span aBytes) noexcept : mBytes(aBytes)
+    {
+    }
+
+    [[nodiscard]] constexpr uint64_t Read(const uint8_t aCount) noexcept
+    {
+        assert(aCount <= CACHE_BITS);
+
+        if (!aCount)
+        {
+            return 0;
+        }
+
+        if (aCount <= mCount)
+        {
+            return Take(aCount);
+        }
+
+        // take what is left in the cache, refill it and take the rest
+        const auto left = static_cast<uint8_t>(aCount - mCount);
+        const auto high = mCount ? Take(mCount) : 0;
+
+        Refill();
+        return (left == CACHE_BITS ? 0 : high << left) | Take(left);
+    }
+
+    [[nodiscard]] constexpr bool ReadBit() noexcept
+    {
+        return Read(1);
+    }
+
+  private:
+    static inline constexpr uint8_t CACHE_BITS = 64;
+
+    span mBytes;
+    Size::size_max mIndex{};
+
+    uint64_t mCache{};
+    uint8_t mCount{};
+
+    constexpr uint64_t Take(const uint8_t aCount) noexcept
+    {
+        const auto bits = mCache >> (CACHE_BITS - aCount);
+
+        mCache = aCount == CACHE_BITS ? 0 : mCache << aCount;
+        mCount -= aCount;
+
+        return bits;
+    }
+
+    constexpr void Refill() noexcept
+    {
+        if (mIndex + sizeof(mCache) <= mBytes.size())
+        {
+            std::memcpy(&mCache, mBytes.data() + mIndex, sizeof(mCache));
+            if constexpr (std::endian::native == std::endian::little)
+            {
+                mCache = ByteSwap(mCache);
+            }
+
+            mIndex += sizeof(mCache);
+        }
+        else
+        {
+            // the tail is shorter than the cache so we load it byte by byte
+            mCache = {};
+            for (uint8_t i = 0; i < sizeof(mCache) && mIndex < mBytes.size(); i++, mIndex++)
+            {
+                mCache |= uint64_t(mBytes[mIndex]) << (CACHE_BITS - 8 * (i + 1));
+            }
+        }
+
+        mCount = CACHE_BITS;
+    }
+};
+} // namespace hbann
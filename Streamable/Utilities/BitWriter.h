@@ -0,0 +1,93 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+namespace hbann
+{
+/*
+    Packs values of 1-64 bits one after another, most significant bit first, into a byte vector.
+
+    The bits are gathered into a 64 bits cache that is flushed as a whole, so the common case is a couple of shifts.
+*/
+class BitWriter
+{
+    using vector = std::vector<uint8_t>;
+
+  public:
+    constexpr BitWriter &Write(const uint64_t aBits, const uint8_t aCount)
+    {
+        assert(aCount <= CACHE_BITS);
+
+        if (!aCount)
+        {
+            return *this;
+        }
+
+        const auto bits = aCount == CACHE_BITS ? aBits : aBits & ((uint64_t(1) << aCount) - 1);
+        const auto free = static_cast<uint8_t>(CACHE_BITS - mCount);
+
+        if (aCount < free)
+        {
+            mCache |= bits << (free - aCount);
+            mCount += aCount;
+        }
+        else
+        {
+            // fill the cache, flush it and keep the bits that did not fit
+            const auto left = static_cast<uint8_t>(aCount - free);
+            mCache |= bits >> left;
+            Flush();
+
+            mCache = left ? bits << (CACHE_BITS - left) : 0;
+            mCount = left;
+        }
+
+        return *this;
+    }
+
+    constexpr BitWriter &WriteBit(const bool aBit)
+    {
+        return Write(aBit, 1);
+    }
+
+    constexpr BitWriter &Reserve(const Size::size_max aBytes)
+    {
+        mBytes.reserve(aBytes);
+        return *this;
+    }
+
+    // Flushes the remaining bits (zero padded to a whole byte) and returns the bytes
+    [[nodiscard]] constexpr vector &&Release()
+    {
+        for (uint8_t i = 0; i < (mCount + 7) / 8; i++)
+        {
+            mBytes.push_back(static_cast<uint8_t>(mCache >> (CACHE_BITS - 8 * (i + 1))));
+        }
+
+        mCache = {};
+        mCount = {};
+
+        return std::move(mBytes);
+    }
+
+  private:
+    static inline constexpr uint8_t CACHE_BITS = 64;
+
+    vector mBytes{};
+    uint64_t mCache{};
+    uint8_t mCount{};
+
+    constexpr void Flush()
+    {
+        uint8_t bytes[sizeof(mCache)]{};
+        const auto cache = std::endian::native == std::endian::little ? ByteSwap(mCache) : mCache;
+        std::memcpy(bytes, &cache, sizeof(cache));
+
+        mBytes.insert(mBytes.end(), bytes, bytes + sizeof(bytes));
+    }
+};
+} // namespace hbann
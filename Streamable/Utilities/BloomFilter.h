@@ -0,0 +1,81 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "Size.h"
+
+namespace hbann
+{
+/*
+    A bloom filter of 64 bit hashes with WORDS words for every KEYS keys (~10 bits per key, ~1% false positives)
+
+    The hashes are computed from the serialized bytes so they are the same on every platform and can be stored.
+*/
+class BloomFilter
+{
+  public:
+    static inline constexpr Size::size_max KEYS = 1024;
+    static inline constexpr Size::size_max WORDS = KEYS * 10 / 64;
+
+    // FNV-1a with a final mix so every bit of the hash depends on every byte
+    [[nodiscard]] static constexpr uint64_t Hash(const std::span<const uint8_t> aBytes) noexcept
+    {
+        uint64_t hash = 0xcbf29ce484222325;
+        for (const auto byte : aBytes)
+        {
+            hash = (hash ^ byte) * 0x100000001b3;
+        }
+
+        hash = (hash ^ (hash >> 33)) * 0xff51afd7ed558ccd;
+        hash = (hash ^ (hash >> 33)) * 0xc4ceb9fe1a85ec53;
+        return hash ^ (hash >> 33);
+    }
+
+    // the count of the words of the filter of the count of keys
+    [[nodiscard]] static constexpr Size::size_max GetWordCount(const Size::size_max aKeyCount) noexcept
+    {
+        return (aKeyCount / KEYS + (aKeyCount % KEYS ? 1 : 0)) * WORDS;
+    }
+
+    static constexpr void Add(const std::span<uint64_t> aWords, const uint64_t aHash) noexcept
+    {
+        ForEachBit(aHash, aWords.size(), [&](const uint64_t aBit) { aWords[aBit / 64] |= uint64_t(1) << (aBit % 64); });
+    }
+
+    // the word at an index is got through a function so the filter can be read from memory of any endianness
+    template <typename FunctionWord>
+    [[nodiscard]] static constexpr bool MayContain(FunctionWord &&aFunctionWord, const Size::size_max aWordCount,
+                                                   const uint64_t aHash) noexcept
+    {
+        if (!aWordCount)
+        {
+            return false;
+        }
+
+        auto contains = true;
+        ForEachBit(aHash, aWordCount,
+                   [&](const uint64_t aBit) { contains &= !!((aFunctionWord(aBit / 64) >> (aBit % 64)) & 1); });
+
+        return contains;
+    }
+
+  private:
+    static inline constexpr uint64_t HASHES = 7;
+
+    // the bits of the hash are found with double hashing from its halves
+    template <typename Function>
+    static constexpr void ForEachBit(const uint64_t aHash, const Size::size_max aWordCount,
+                                     Function &&aFunction) noexcept
+    {
+        const auto step = (aHash >> 32) | 1;
+        for (uint64_t i = 0; i < HASHES; i++)
+        {
+            aFunction((aHash + i * step) % (aWordCount * 64));
+        }
+    }
+};
+} // namespace hbann
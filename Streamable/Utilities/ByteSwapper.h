@@ -0,0 +1,110 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+namespace hbann
+{
+/*
+    Reverses the bytes of arithmetic/enum values and of arrays of them
+
+    The arrays are swapped 16 bytes at a time with SSSE3/NEON byte shuffles when they are available.
+*/
+class ByteSwapper
+{
+  public:
+    template <typename Type> [[nodiscard]] static constexpr Type Swap(const Type aValue) noexcept
+    {
+        static_assert(is_byte_swappable<Type>, "Type can not be byte swapped!");
+
+        if constexpr (sizeof(Type) == 1)
+        {
+            return aValue;
+        }
+        else
+        {
+            using TypeBits = bits_t<Type>;
+            return std::bit_cast<Type>(::hbann::ByteSwap(std::bit_cast<TypeBits>(aValue)));
+        }
+    }
+
+    template <typename Type> static inline void Swap(const std::span<const Type> aFrom, const std::span<Type> aTo) noexcept
+    {
+        static_assert(is_byte_swappable<Type>, "Type can not be byte swapped!");
+        assert(aFrom.size() == aTo.size());
+
+        if constexpr (sizeof(Type) == 1)
+        {
+            std::memmove(aTo.data(), aFrom.data(), aFrom.size_bytes());
+        }
+        else
+        {
+            Size::size_max i{};
+#if defined(STREAMABLE_HAS_SSSE3) || defined(STREAMABLE_HAS_NEON)
+            const auto from = reinterpret_cast<const uint8_t *>(aFrom.data());
+            const auto to = reinterpret_cast<uint8_t *>(aTo.data());
+#endif // STREAMABLE_HAS_SSSE3 || STREAMABLE_HAS_NEON
+
+#if defined(STREAMABLE_HAS_SSSE3)
+            const auto mask = MakeMask<sizeof(Type)>();
+            for (; i + 16 <= aFrom.size_bytes(); i += 16)
+            {
+                const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(from + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(to + i), _mm_shuffle_epi8(bytes, mask));
+            }
+#elif defined(STREAMABLE_HAS_NEON)
+            for (; i + 16 <= aFrom.size_bytes(); i += 16)
+            {
+                const auto bytes = vld1q_u8(from + i);
+                if constexpr (sizeof(Type) == 2)
+                {
+                    vst1q_u8(to + i, vrev16q_u8(bytes));
+                }
+                else if constexpr (sizeof(Type) == 4)
+                {
+                    vst1q_u8(to + i, vrev32q_u8(bytes));
+                }
+                else
+                {
+                    vst1q_u8(to + i, vrev64q_u8(bytes));
+                }
+            }
+#endif // STREAMABLE_HAS_SSSE3
+
+            // the tail or the whole array when there are no byte shuffles
+            for (i /= sizeof(Type); i < aFrom.size(); i++)
+            {
+                aTo[i] = Swap(aFrom[i]);
+            }
+        }
+    }
+
+    template <typename Type> static inline void Swap(const std::span<Type> aValues) noexcept
+    {
+        Swap(std::span<const Type>(aValues), aValues);
+    }
+
+  private:
+    template <typename Type>
+    using bits_t = std::conditional_t<
+        sizeof(Type) == 8, uint64_t,
+        std::conditional_t<sizeof(Type) == 4, uint32_t, std::conditional_t<sizeof(Type) == 2, uint16_t, uint8_t>>>;
+
+#ifdef STREAMABLE_HAS_SSSE3
+    // reverses every group of 'vSize' bytes
+    template <size_t vSize> static inline __m128i MakeMask() noexcept
+    {
+        alignas(16) uint8_t mask[16]{};
+        for (uint8_t i = 0; i < 16; i++)
+        {
+            mask[i] = static_cast<uint8_t>((i / vSize) * vSize + (vSize - 1 - i % vSize));
+        }
+
+        return _mm_load_si128(reinterpret_cast<const __m128i *>(mask));
+    }
+#endif // STREAMABLE_HAS_SSSE3
+};
+} // namespace hbann
@@ -11,6 +11,13 @@ namespace hbann
 class Converter
 {
   public:
+    // else the UTF16 strings are written as raw bytes
+#ifdef _WIN32
+    static inline constexpr auto IS_ENCODING_UTF8 = true;
+#else
+    static inline constexpr auto IS_ENCODING_UTF8 = false;
+#endif // _WIN32
+
     template <typename Type> [[nodiscard]] static constexpr auto Encode(const Type &aString)
     {
         static_assert(is_utf16string<Type>, "Type must be a UTF16 string!");
@@ -0,0 +1,193 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "Size.h"
+
+namespace hbann
+{
+/*
+    CRC32C (Castagnoli) of bytes that can be computed in parts, ex.:
+        auto crc = ::hbann::Crc32c::Extend(0, header);
+        crc = ::hbann::Crc32c::Extend(crc, payload);
+
+    It uses the crc32 instructions of SSE4.2/ARMv8 and the slicing by 8 tables otherwise. The instructions take 3
+   cycles but a new one can start every cycle so the long ranges are split in 3 parts computed at once and combined.
+*/
+class Crc32c
+{
+  public:
+    // continues the CRC of the bytes before (0 for none) with the bytes
+    [[nodiscard]] static inline uint32_t Extend(const uint32_t aCrc, std::span<const uint8_t> aBytes) noexcept
+    {
+        auto crc = ~aCrc;
+
+#if defined(STREAMABLE_HAS_SSE42) || defined(STREAMABLE_HAS_ARM_CRC32)
+        crc = ExtendParallel<PART_LONG>(crc, aBytes);
+        crc = ExtendParallel<PART_SHORT>(crc, aBytes);
+
+        for (; aBytes.size() >= sizeof(uint64_t); aBytes = aBytes.subspan(sizeof(uint64_t)))
+        {
+            crc = Step(crc, aBytes.data());
+        }
+
+        for (const auto byte : aBytes)
+        {
+#ifdef STREAMABLE_HAS_SSE42
+            crc = _mm_crc32_u8(crc, byte);
+#else
+            crc = __crc32cb(crc, byte);
+#endif // STREAMABLE_HAS_SSE42
+        }
+#else
+        for (; aBytes.size() >= sizeof(uint64_t); aBytes = aBytes.subspan(sizeof(uint64_t)))
+        {
+            const auto &b = aBytes;
+            const auto low = crc ^ (b[0] | (b[1] << 8) | (b[2] << 16) | (uint32_t(b[3]) << 24));
+
+            crc = TABLES[7][low & 0xFF] ^ TABLES[6][(low >> 8) & 0xFF] ^ TABLES[5][(low >> 16) & 0xFF] ^
+                  TABLES[4][low >> 24] ^ TABLES[3][b[4]] ^ TABLES[2][b[5]] ^ TABLES[1][b[6]] ^ TABLES[0][b[7]];
+        }
+
+        for (const auto byte : aBytes)
+        {
+            crc = TABLES[0][(crc ^ byte) & 0xFF] ^ (crc >> 8);
+        }
+#endif // STREAMABLE_HAS_SSE42 || STREAMABLE_HAS_ARM_CRC32
+
+        return ~crc;
+    }
+
+  private:
+    static inline constexpr uint32_t POLYNOMIAL = 0x82F63B78; // reflected 0x1EDC6F41
+
+    static inline constexpr Size::size_max PART_LONG = 8 * 1024;
+    static inline constexpr Size::size_max PART_SHORT = 256;
+
+    using shift = std::array<std::array<uint32_t, 256>, 4>;
+
+    // the table that appends the count of zero bytes to a CRC (the count must be a power of 2), the CRC is multiplied
+    // by x^(8 * count) modulo the polynomial with the operator matrix of one zero bit squared until it has the count
+    template <Size::size_max vZeros> static inline constexpr shift SHIFT = [] {
+        using matrix = std::array<uint32_t, 32>;
+
+        const auto multiply = [](const matrix &aMatrix, uint32_t aVector) {
+            uint32_t product{};
+            for (size_t i = 0; aVector; i++, aVector >>= 1)
+            {
+                product ^= aVector & 1 ? aMatrix[i] : 0;
+            }
+
+            return product;
+        };
+
+        const auto square = [&](const matrix &aMatrix) {
+            matrix squared{};
+            for (size_t i = 0; i < squared.size(); i++)
+            {
+                squared[i] = multiply(aMatrix, aMatrix[i]);
+            }
+
+            return squared;
+        };
+
+        matrix zeros{POLYNOMIAL};
+        for (size_t i = 1; i < zeros.size(); i++)
+        {
+            zeros[i] = uint32_t(1) << (i - 1);
+        }
+
+        // one zero bit squared 3 times is one zero byte
+        for (auto bits = std::bit_width(vZeros) + 2; bits; bits--)
+        {
+            zeros = square(zeros);
+        }
+
+        shift result{};
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            for (size_t byte = 0; byte < result.size(); byte++)
+            {
+                result[byte][i] = multiply(zeros, i << (byte * 8));
+            }
+        }
+
+        return result;
+    }();
+
+#if defined(STREAMABLE_HAS_SSE42) || defined(STREAMABLE_HAS_ARM_CRC32)
+    [[nodiscard]] static inline uint32_t Step(const uint32_t aCrc, const uint8_t *aBytes) noexcept
+    {
+        uint64_t word{};
+        std::memcpy(&word, aBytes, sizeof(word));
+
+#ifdef STREAMABLE_HAS_SSE42
+        return static_cast<uint32_t>(_mm_crc32_u64(aCrc, word));
+#else
+        return __crc32cd(aCrc, word);
+#endif // STREAMABLE_HAS_SSE42
+    }
+
+    // the CRCs of 3 parts of the bytes are computed at once and the ones before are shifted over the parts after them
+    template <Size::size_max vPart>
+    [[nodiscard]] static inline uint32_t ExtendParallel(uint32_t aCrc, std::span<const uint8_t> &aBytes) noexcept
+    {
+        static_assert(std::has_single_bit(vPart) && vPart % sizeof(uint64_t) == 0, "The part is not a power of 2!");
+
+        for (; aBytes.size() >= vPart * 3; aBytes = aBytes.subspan(vPart * 3))
+        {
+            uint32_t crc1{}, crc2{};
+            for (Size::size_max i = 0; i < vPart; i += sizeof(uint64_t))
+            {
+                aCrc = Step(aCrc, aBytes.data() + i);
+                crc1 = Step(crc1, aBytes.data() + vPart + i);
+                crc2 = Step(crc2, aBytes.data() + vPart * 2 + i);
+            }
+
+            aCrc = Shift<vPart>(aCrc) ^ crc1;
+            aCrc = Shift<vPart>(aCrc) ^ crc2;
+        }
+
+        return aCrc;
+    }
+#endif // STREAMABLE_HAS_SSE42 || STREAMABLE_HAS_ARM_CRC32
+
+    template <Size::size_max vZeros> [[nodiscard]] static constexpr uint32_t Shift(const uint32_t aCrc) noexcept
+    {
+        const auto &shift = SHIFT<vZeros>;
+        return shift[0][aCrc & 0xFF] ^ shift[1][(aCrc >> 8) & 0xFF] ^ shift[2][(aCrc >> 16) & 0xFF] ^
+               shift[3][aCrc >> 24];
+    }
+
+    using tables = std::array<std::array<uint32_t, 256>, 8>;
+
+    // the table i is the CRC of a byte followed by i zero bytes
+    static inline constexpr tables TABLES = [] {
+        tables result{};
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            auto crc = i;
+            for (auto bit = 0; bit < 8; bit++)
+            {
+                crc = (crc >> 1) ^ (crc & 1 ? POLYNOMIAL : 0);
+            }
+
+            result[0][i] = crc;
+        }
+
+        for (size_t table = 1; table < result.size(); table++)
+        {
+            for (size_t i = 0; i < 256; i++)
+            {
+                result[table][i] = result[0][result[table - 1][i] & 0xFF] ^ (result[table - 1][i] >> 8);
+            }
+        }
+
+        return result;
+    }();
+};
+} // namespace hbann
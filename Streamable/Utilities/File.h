@@ -0,0 +1,320 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "Size.h"
+
+namespace hbann
+{
+/*
+    A native file (a file descriptor or a Windows handle) read and written at offsets without a file position so the
+   transfers can be done in any order (see FileRing)
+*/
+class File
+{
+  public:
+#ifdef _WIN32
+    using handle = HANDLE;
+#else
+    using handle = int;
+#endif // _WIN32
+
+    File() noexcept = default;
+
+    // takes the ownership of a handle opened by someone else (see Release)
+    explicit File(const handle aHandle) noexcept : mHandle(aHandle)
+    {
+    }
+
+    // the file is truncated when serializing unless it is appended to
+    explicit File(const std::filesystem::path &aPath, const StreamUsageType aStreamUsageType,
+                  const bool aAppend = false)
+    {
+        const auto serialize = aStreamUsageType == StreamUsageType::SERIALIZE;
+
+#ifdef _WIN32
+        mHandle = CreateFileW(aPath.c_str(), serialize ? GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              serialize ? (aAppend ? OPEN_ALWAYS : CREATE_ALWAYS) : OPEN_EXISTING,
+                              serialize ? FILE_ATTRIBUTE_NORMAL : FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+#else
+        mHandle = serialize ? open(aPath.c_str(), O_WRONLY | O_CREAT | (aAppend ? 0 : O_TRUNC) | O_CLOEXEC, 0666)
+                            : open(aPath.c_str(), O_RDONLY | O_CLOEXEC);
+#endif // _WIN32
+
+        assert(IsOpen());
+    }
+
+    File(const File &) = delete;
+
+    File(File &&aFile) noexcept
+    {
+        *this = std::move(aFile);
+    }
+
+    ~File() noexcept
+    {
+        Close();
+    }
+
+    File &operator=(const File &) = delete;
+
+    File &operator=(File &&aFile) noexcept
+    {
+        std::swap(mHandle, aFile.mHandle);
+        return *this;
+    }
+
+    [[nodiscard]] bool IsOpen() const noexcept
+    {
+        return mHandle != HANDLE_INVALID;
+    }
+
+    [[nodiscard]] handle GetHandle() const noexcept
+    {
+        return mHandle;
+    }
+
+    [[nodiscard]] Size::size_max GetSize() const noexcept
+    {
+#ifdef _WIN32
+        LARGE_INTEGER size{};
+        return GetFileSizeEx(mHandle, &size) ? static_cast<Size::size_max>(size.QuadPart) : 0;
+#else
+        struct stat status{};
+        return fstat(mHandle, &status) ? 0 : static_cast<Size::size_max>(status.st_size);
+#endif // _WIN32
+    }
+
+    // reads until the bytes are full or the end of the file is reached, returns the count of the bytes read
+    Size::size_max ReadAt(const std::span<uint8_t> aBytes, const Size::size_max aOffset) noexcept
+    {
+        Size::size_max count{};
+        while (count < aBytes.size())
+        {
+            const auto read = Transfer(aBytes.data() + count, aBytes.size() - count, aOffset + count, false);
+            if (!read)
+            {
+                break;
+            }
+
+            count += read;
+        }
+
+        return count;
+    }
+
+    // writes all the bytes, returns the count of the bytes written that is smaller only when the write failed
+    Size::size_max WriteAt(const std::span<const uint8_t> aBytes, const Size::size_max aOffset) noexcept
+    {
+        Size::size_max count{};
+        while (count < aBytes.size())
+        {
+            const auto written = Transfer(const_cast<uint8_t *>(aBytes.data()) + count, aBytes.size() - count,
+                                          aOffset + count, true);
+            if (!written)
+            {
+                break;
+            }
+
+            count += written;
+        }
+
+        return count;
+    }
+
+    // moves the bytes from this file to the other one in the kernel without copying them through memory, a file
+    // without an offset (ex.: a pipe or a socket) is transferred at its position, returns the count of the bytes moved
+    // that is smaller when the files can't do it so the rest must be copied
+    Size::size_max SendTo(const File &aFile, const std::optional<Size::size_max> aOffset,
+                          const std::optional<Size::size_max> aOffsetTo, const Size::size_max aSize) const noexcept
+    {
+#ifdef STREAMABLE_HAS_SENDFILE
+        Size::size_max count{};
+        while (count < aSize)
+        {
+            // a transfer can't be bigger than ~2GB
+            const auto size = std::min<Size::size_max>(aSize - count, 1 << 30);
+
+            // copy_file_range between regular files, sendfile from a regular file and splice from a pipe
+            off_t offset = aOffset ? static_cast<off_t>(*aOffset + count) : 0;
+            off_t offsetTo = aOffsetTo ? static_cast<off_t>(*aOffsetTo + count) : 0;
+
+            ssize_t moved{};
+            if (aOffset && aOffsetTo)
+            {
+                moved = copy_file_range(mHandle, &offset, aFile.mHandle, &offsetTo, size, 0);
+            }
+            else if (aOffset)
+            {
+                moved = sendfile(aFile.mHandle, mHandle, &offset, size);
+            }
+            else
+            {
+                moved = splice(mHandle, nullptr, aFile.mHandle, aOffsetTo ? &offsetTo : nullptr, size, SPLICE_F_MOVE);
+            }
+
+            if (moved < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            // the side without an offset can be a descriptor that is not blocking
+            if (moved < 0 && errno == EAGAIN)
+            {
+                pollfd descriptor{aOffset ? aFile.mHandle : mHandle, static_cast<short>(aOffset ? POLLOUT : POLLIN), 0};
+                poll(&descriptor, 1, -1);
+                continue;
+            }
+
+            if (moved <= 0)
+            {
+                break;
+            }
+
+            count += static_cast<Size::size_max>(moved);
+        }
+
+        return count;
+#else
+        (void)aFile, (void)aOffset, (void)aOffsetTo, (void)aSize;
+        return 0;
+#endif // STREAMABLE_HAS_SENDFILE
+    }
+
+    // makes the bytes written durable so they survive a crash of the system, returns false when it failed
+    bool Sync() const noexcept
+    {
+#ifdef _WIN32
+        return FlushFileBuffers(mHandle);
+#elif defined(__APPLE__)
+        // fsync doesn't flush the cache of the drive on macOS
+        return fcntl(mHandle, F_FULLFSYNC) != -1;
+#elif defined(__linux__)
+        // the metadata that is not needed to read the bytes back (ex.: the times) is not synced
+        return !fdatasync(mHandle);
+#else
+        return !fsync(mHandle);
+#endif // _WIN32
+    }
+
+    // makes the files created, renamed and removed in the directory durable, returns false when it failed
+    static bool SyncDirectory(const std::filesystem::path &aDirectory) noexcept
+    {
+#ifdef _WIN32
+        // the directory entries are written through by Replace
+        (void)aDirectory;
+        return true;
+#else
+        File directory(open(aDirectory.empty() ? "." : aDirectory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+        return directory.IsOpen() && directory.Sync();
+#endif // _WIN32
+    }
+
+    // creates a file that didn't exist before next to the path (ex.: "file.bin.0.tmp") so no other file is truncated,
+    // the path of the file created is empty when it failed
+    static File CreateTemporary(const std::filesystem::path &aPath, std::filesystem::path &aPathTemporary)
+    {
+        // the names taken by other files are skipped until one is created
+        static std::atomic<uint32_t> counter{};
+        while (true)
+        {
+            aPathTemporary = aPath;
+            aPathTemporary += "." + std::to_string(counter++) + ".tmp";
+
+#ifdef _WIN32
+            File file(CreateFileW(aPathTemporary.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_NEW,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr));
+            const auto exists = !file.IsOpen() && GetLastError() == ERROR_FILE_EXISTS;
+#else
+            File file(open(aPathTemporary.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666));
+            const auto exists = !file.IsOpen() && errno == EEXIST;
+#endif // _WIN32
+
+            if (exists)
+            {
+                continue;
+            }
+
+            if (!file.IsOpen())
+            {
+                aPathTemporary.clear();
+            }
+
+            return file;
+        }
+    }
+
+    // replaces the file with the other one atomically so a crash leaves one of them whole, returns false when it failed
+    static bool Replace(const std::filesystem::path &aPath, const std::filesystem::path &aPathTo) noexcept
+    {
+#ifdef _WIN32
+        return MoveFileExW(aPath.c_str(), aPathTo.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+        return !rename(aPath.c_str(), aPathTo.c_str()) && SyncDirectory(aPathTo.parent_path());
+#endif // _WIN32
+    }
+
+    // gives up the ownership of the handle without closing it
+    handle Release() noexcept
+    {
+        return std::exchange(mHandle, HANDLE_INVALID);
+    }
+
+    void Close() noexcept
+    {
+        if (!IsOpen())
+        {
+            return;
+        }
+
+#ifdef _WIN32
+        CloseHandle(mHandle);
+#else
+        close(mHandle);
+#endif // _WIN32
+
+        mHandle = HANDLE_INVALID;
+    }
+
+  private:
+#ifdef _WIN32
+    static inline const handle HANDLE_INVALID = INVALID_HANDLE_VALUE;
+#else
+    static inline constexpr handle HANDLE_INVALID = -1;
+#endif // _WIN32
+
+    // a single read/write at an offset that can transfer less than requested, 0 means the end of the file or an error
+    Size::size_max Transfer(uint8_t *aBytes, const Size::size_max aSize, const Size::size_max aOffset,
+                            const bool aWrite) noexcept
+    {
+#ifdef _WIN32
+        OVERLAPPED overlapped{};
+        overlapped.Offset = static_cast<DWORD>(aOffset);
+        overlapped.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(aOffset) >> 32);
+
+        // a transfer can't be bigger than a DWORD
+        const auto size = static_cast<DWORD>(std::min<Size::size_max>(aSize, 1 << 30));
+
+        DWORD transferred{};
+        const auto result = aWrite ? WriteFile(mHandle, aBytes, size, &transferred, &overlapped)
+                                   : ReadFile(mHandle, aBytes, size, &transferred, &overlapped);
+        return result ? transferred : 0;
+#else
+        ssize_t transferred{};
+        do
+        {
+            transferred = aWrite ? pwrite(mHandle, aBytes, aSize, static_cast<off_t>(aOffset))
+                                 : pread(mHandle, aBytes, aSize, static_cast<off_t>(aOffset));
+        } while (transferred < 0 && errno == EINTR);
+
+        return transferred > 0 ? static_cast<Size::size_max>(transferred) : 0;
+#endif // _WIN32
+    }
+
+    handle mHandle = HANDLE_INVALID;
+};
+} // namespace hbann
@@ -0,0 +1,115 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "File.h"
+
+namespace hbann
+{
+/*
+    A file mapped read only in memory so its bytes can be used without reading them first, only the pages that are
+   touched are read by the system
+*/
+class FileMapping
+{
+  public:
+    FileMapping() noexcept = default;
+
+    // the pages are expected to be used in a random order (see madvise) unless they are read sequentially
+    explicit FileMapping(const std::filesystem::path &aPath, const bool aSequential = false)
+        : mFile(aPath, StreamUsageType::DESERIALIZE), mSize(mFile.GetSize())
+    {
+        if (!mSize)
+        {
+            return;
+        }
+
+#ifdef _WIN32
+        mMapping = CreateFileMappingW(mFile.GetHandle(), nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mMapping)
+        {
+            mData = static_cast<const uint8_t *>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+        }
+#else
+        const auto data = mmap(nullptr, mSize, PROT_READ, MAP_SHARED, mFile.GetHandle(), 0);
+        if (data != MAP_FAILED)
+        {
+            mData = static_cast<const uint8_t *>(data);
+            madvise(data, mSize, aSequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+        }
+#endif // _WIN32
+
+        assert(mData);
+    }
+
+    FileMapping(const FileMapping &) = delete;
+
+    FileMapping(FileMapping &&aFileMapping) noexcept
+    {
+        *this = std::move(aFileMapping);
+    }
+
+    ~FileMapping() noexcept
+    {
+        Unmap();
+    }
+
+    FileMapping &operator=(const FileMapping &) = delete;
+
+    FileMapping &operator=(FileMapping &&aFileMapping) noexcept
+    {
+        std::swap(mFile, aFileMapping.mFile);
+        std::swap(mSize, aFileMapping.mSize);
+        std::swap(mData, aFileMapping.mData);
+
+#ifdef _WIN32
+        std::swap(mMapping, aFileMapping.mMapping);
+#endif // _WIN32
+
+        return *this;
+    }
+
+    [[nodiscard]] std::span<const uint8_t> View() const noexcept
+    {
+        return {mData, mData ? mSize : 0};
+    }
+
+    void Unmap() noexcept
+    {
+#ifdef _WIN32
+        if (mData)
+        {
+            UnmapViewOfFile(mData);
+        }
+
+        if (mMapping)
+        {
+            CloseHandle(mMapping);
+            mMapping = nullptr;
+        }
+#else
+        if (mData)
+        {
+            munmap(const_cast<uint8_t *>(mData), mSize);
+        }
+#endif // _WIN32
+
+        mData = nullptr;
+        mSize = {};
+        mFile.Close();
+    }
+
+  private:
+    File mFile;
+    Size::size_max mSize{};
+    const uint8_t *mData{};
+
+#ifdef _WIN32
+    HANDLE mMapping{};
+#endif // _WIN32
+};
+} // namespace hbann
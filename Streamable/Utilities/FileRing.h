@@ -0,0 +1,403 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "File.h"
+
+namespace hbann
+{
+/*
+    Transfers fixed buffers to/from a file in the background so the caller can fill/consume a buffer while the other
+   ones are written/read, every buffer has at most one transfer in flight.
+
+    On Linux it uses io_uring with the buffers registered once, the transfers are queued and submitted together by
+   Flush/Wait. When io_uring is not available (other platforms, old kernels, seccomp etc...) the transfers are done
+   synchronously when they are queued.
+*/
+class FileRing
+{
+  public:
+    FileRing() noexcept = default;
+
+    explicit FileRing(const std::span<const std::span<uint8_t>> aBuffers)
+        : mBuffers(aBuffers.begin(), aBuffers.end()), mTransfers(aBuffers.size())
+    {
+#ifdef STREAMABLE_HAS_IO_URING
+        Setup();
+#endif // STREAMABLE_HAS_IO_URING
+    }
+
+    FileRing(const FileRing &) = delete;
+
+    FileRing(FileRing &&aFileRing) noexcept
+    {
+        *this = std::move(aFileRing);
+    }
+
+    ~FileRing() noexcept
+    {
+#ifdef STREAMABLE_HAS_IO_URING
+        // the kernel must be done with the buffers before they are freed
+        for (auto &transfer : mTransfers)
+        {
+            while (transfer.pending)
+            {
+                if (!Enter(1))
+                {
+                    Abandon();
+                    break;
+                }
+
+                Reap();
+            }
+        }
+
+        Teardown();
+#endif // STREAMABLE_HAS_IO_URING
+    }
+
+    FileRing &operator=(const FileRing &) = delete;
+
+    FileRing &operator=(FileRing &&aFileRing) noexcept
+    {
+        std::swap(mBuffers, aFileRing.mBuffers);
+        std::swap(mTransfers, aFileRing.mTransfers);
+
+#ifdef STREAMABLE_HAS_IO_URING
+        std::swap(mRing, aFileRing.mRing);
+#endif // STREAMABLE_HAS_IO_URING
+
+        return *this;
+    }
+
+    [[nodiscard]] bool IsAsync() const noexcept
+    {
+#ifdef STREAMABLE_HAS_IO_URING
+        return mRing.fd >= 0;
+#else
+        return false;
+#endif // STREAMABLE_HAS_IO_URING
+    }
+
+    // starts writing the first bytes of the buffer at the offset of the file
+    void SubmitWrite(File &aFile, const size_t aBuffer, const Size::size_max aSize, const Size::size_max aOffset)
+    {
+        Submit(aFile, aBuffer, aSize, aOffset, true);
+    }
+
+    // starts reading into the first bytes of the buffer from the offset of the file
+    void SubmitRead(File &aFile, const size_t aBuffer, const Size::size_max aSize, const Size::size_max aOffset)
+    {
+        Submit(aFile, aBuffer, aSize, aOffset, false);
+    }
+
+    // submits the queued transfers with a single system call
+    void Flush() noexcept
+    {
+#ifdef STREAMABLE_HAS_IO_URING
+        if (mRing.queued)
+        {
+            Enter(0);
+        }
+#endif // STREAMABLE_HAS_IO_URING
+    }
+
+    // waits for the transfer of the buffer to end, returns the count of the bytes transferred
+    Size::size_max Wait(File &aFile, const size_t aBuffer)
+    {
+        auto &transfer = mTransfers[aBuffer];
+
+#ifdef STREAMABLE_HAS_IO_URING
+        while (transfer.pending)
+        {
+            if (!Enter(1))
+            {
+                Abandon();
+                break;
+            }
+
+            Reap();
+        }
+
+        // the dropped, failed or short transfers are finished synchronously
+        if (transfer.pending || transfer.result < 0 || static_cast<Size::size_max>(transfer.result) < transfer.size)
+        {
+            const auto done = static_cast<Size::size_max>(std::max<int64_t>(transfer.result, 0));
+            transfer.result = static_cast<int64_t>(done + Transfer(aFile, aBuffer, done));
+            transfer.pending = false;
+        }
+#else
+        (void)aFile;
+#endif // STREAMABLE_HAS_IO_URING
+
+        return static_cast<Size::size_max>(transfer.result);
+    }
+
+    // the count of the bytes submitted for the last transfer of the buffer
+    [[nodiscard]] Size::size_max GetSize(const size_t aBuffer) const noexcept
+    {
+        return mTransfers[aBuffer].size;
+    }
+
+  private:
+    struct operation
+    {
+        Size::size_max size{};
+        Size::size_max offset{};
+        int64_t result{};
+        bool write{};
+        bool pending{};
+    };
+
+    std::vector<std::span<uint8_t>> mBuffers{};
+    std::vector<operation> mTransfers{};
+
+    void Submit(File &aFile, const size_t aBuffer, const Size::size_max aSize, const Size::size_max aOffset,
+                const bool aWrite)
+    {
+        assert(aSize <= mBuffers[aBuffer].size());
+
+        auto &transfer = mTransfers[aBuffer];
+        assert(!transfer.pending);
+        transfer = {aSize, aOffset, 0, aWrite, false};
+
+#ifdef STREAMABLE_HAS_IO_URING
+        if (IsAsync())
+        {
+            Queue(aFile, aBuffer);
+            return;
+        }
+#endif // STREAMABLE_HAS_IO_URING
+
+        transfer.result = static_cast<int64_t>(Transfer(aFile, aBuffer, 0));
+    }
+
+    // the synchronous transfer of the buffer from the byte at the index
+    Size::size_max Transfer(File &aFile, const size_t aBuffer, const Size::size_max aIndex)
+    {
+        const auto &transfer = mTransfers[aBuffer];
+        const auto bytes = mBuffers[aBuffer].subspan(aIndex, transfer.size - aIndex);
+
+        return transfer.write ? aFile.WriteAt(bytes, transfer.offset + aIndex)
+                              : aFile.ReadAt(bytes, transfer.offset + aIndex);
+    }
+
+#ifdef STREAMABLE_HAS_IO_URING
+    static inline constexpr unsigned ENTRIES = 8;
+
+    struct ring
+    {
+        int fd = -1;
+        bool fixed{};
+
+        void *sq = MAP_FAILED;
+        size_t sqSize{};
+        void *cq = MAP_FAILED;
+        size_t cqSize{};
+        io_uring_sqe *sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+        size_t sqesSize{};
+
+        unsigned *sqHead{};
+        unsigned *sqTail{};
+        unsigned *sqMask{};
+        unsigned *sqArray{};
+        unsigned *cqHead{};
+        unsigned *cqTail{};
+        unsigned *cqMask{};
+        io_uring_cqe *cqes{};
+
+        unsigned queued{};
+    };
+
+    ring mRing{};
+
+    template <typename Type> [[nodiscard]] static Type *Offset(void *aRing, const uint32_t aOffset) noexcept
+    {
+        return reinterpret_cast<Type *>(static_cast<uint8_t *>(aRing) + aOffset);
+    }
+
+    void Setup() noexcept
+    {
+        io_uring_params params{};
+        mRing.fd = static_cast<int>(syscall(__NR_io_uring_setup, ENTRIES, &params));
+        if (mRing.fd < 0)
+        {
+            return;
+        }
+
+        mRing.sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        mRing.cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        mRing.sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+        // the submission and the completion rings can share the same mapping
+        const auto singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMap)
+        {
+            mRing.sqSize = mRing.cqSize = std::max(mRing.sqSize, mRing.cqSize);
+        }
+
+        const auto map = [&](const size_t aSize, const off_t aOffset) {
+            return mmap(nullptr, aSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRing.fd, aOffset);
+        };
+
+        mRing.sq = map(mRing.sqSize, IORING_OFF_SQ_RING);
+        mRing.cq = singleMap ? mRing.sq : map(mRing.cqSize, IORING_OFF_CQ_RING);
+        mRing.sqes = static_cast<io_uring_sqe *>(map(mRing.sqesSize, IORING_OFF_SQES));
+        if (mRing.sq == MAP_FAILED || mRing.cq == MAP_FAILED || mRing.sqes == MAP_FAILED)
+        {
+            Teardown();
+            return;
+        }
+
+        mRing.sqHead = Offset<unsigned>(mRing.sq, params.sq_off.head);
+        mRing.sqTail = Offset<unsigned>(mRing.sq, params.sq_off.tail);
+        mRing.sqMask = Offset<unsigned>(mRing.sq, params.sq_off.ring_mask);
+        mRing.sqArray = Offset<unsigned>(mRing.sq, params.sq_off.array);
+        mRing.cqHead = Offset<unsigned>(mRing.cq, params.cq_off.head);
+        mRing.cqTail = Offset<unsigned>(mRing.cq, params.cq_off.tail);
+        mRing.cqMask = Offset<unsigned>(mRing.cq, params.cq_off.ring_mask);
+        mRing.cqes = Offset<io_uring_cqe>(mRing.cq, params.cq_off.cqes);
+
+        // the registered buffers are pinned once instead of at every transfer, it is just faster so it can fail
+        std::vector<iovec> iovecs{};
+        for (const auto &buffer : mBuffers)
+        {
+            iovecs.push_back({buffer.data(), buffer.size()});
+        }
+
+        mRing.fixed = !syscall(__NR_io_uring_register, mRing.fd, IORING_REGISTER_BUFFERS, iovecs.data(),
+                               static_cast<unsigned>(iovecs.size()));
+    }
+
+    void Teardown() noexcept
+    {
+        if (mRing.sqes != MAP_FAILED)
+        {
+            munmap(mRing.sqes, mRing.sqesSize);
+        }
+
+        if (mRing.cq != MAP_FAILED && mRing.cq != mRing.sq)
+        {
+            munmap(mRing.cq, mRing.cqSize);
+        }
+
+        if (mRing.sq != MAP_FAILED)
+        {
+            munmap(mRing.sq, mRing.sqSize);
+        }
+
+        if (mRing.fd >= 0)
+        {
+            close(mRing.fd);
+        }
+
+        mRing = {};
+    }
+
+    void Queue(File &aFile, const size_t aBuffer) noexcept
+    {
+        auto &transfer = mTransfers[aBuffer];
+
+        // we are the only producer so the tail is read relaxed
+        std::atomic_ref sqTail(*mRing.sqTail);
+        const auto tail = sqTail.load(std::memory_order_relaxed);
+        const auto index = tail & *mRing.sqMask;
+
+        auto &sqe = mRing.sqes[index];
+        sqe = {};
+        sqe.opcode = static_cast<uint8_t>(transfer.write ? (mRing.fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE)
+                                                         : (mRing.fixed ? IORING_OP_READ_FIXED : IORING_OP_READ));
+        sqe.fd = aFile.GetHandle();
+        sqe.off = transfer.offset;
+        sqe.addr = reinterpret_cast<uint64_t>(mBuffers[aBuffer].data());
+        sqe.len = static_cast<uint32_t>(transfer.size);
+        sqe.buf_index = static_cast<uint16_t>(aBuffer);
+        sqe.user_data = aBuffer;
+
+        mRing.sqArray[index] = index;
+        sqTail.store(tail + 1, std::memory_order_release);
+
+        mRing.queued++;
+        transfer.pending = true;
+    }
+
+    // submits the queued transfers and waits for the completions, false when the ring can't be used anymore
+    bool Enter(const unsigned aComplete) noexcept
+    {
+        long result{};
+        do
+        {
+            result = syscall(__NR_io_uring_enter, mRing.fd, mRing.queued, aComplete,
+                             aComplete ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+        } while (result < 0 && errno == EINTR);
+
+        if (result >= 0)
+        {
+            mRing.queued -= std::min(mRing.queued, static_cast<unsigned>(result));
+        }
+
+        return result >= 0;
+    }
+
+    // the ring can't be entered anymore so the transfers the kernel didn't take are dropped (they are done
+    // synchronously by Wait) and the ones it took are waited for before the buffers are used again, the next transfers
+    // are synchronous
+    void Abandon() noexcept
+    {
+        // the kernel takes the submissions only when it is entered so the head doesn't move meanwhile
+        std::atomic_ref sqHead(*mRing.sqHead);
+        std::atomic_ref sqTail(*mRing.sqTail);
+
+        const auto head = sqHead.load(std::memory_order_acquire);
+        for (auto i = head; i != sqTail.load(std::memory_order_relaxed); i++)
+        {
+            auto &transfer = mTransfers[mRing.sqes[mRing.sqArray[i & *mRing.sqMask]].user_data];
+            transfer.result = 0;
+            transfer.pending = false;
+        }
+
+        sqTail.store(head, std::memory_order_release);
+        mRing.queued = 0;
+
+        while (std::ranges::any_of(mTransfers, &operation::pending))
+        {
+            if (!Enter(1) && errno != EAGAIN && errno != EBUSY)
+            {
+                break;
+            }
+
+            Reap();
+        }
+
+        Teardown();
+        for (auto &transfer : mTransfers)
+        {
+            transfer.pending = false;
+        }
+    }
+
+    void Reap() noexcept
+    {
+        std::atomic_ref cqHead(*mRing.cqHead);
+        std::atomic_ref cqTail(*mRing.cqTail);
+
+        auto head = cqHead.load(std::memory_order_relaxed);
+        const auto tail = cqTail.load(std::memory_order_acquire);
+        for (; head != tail; head++)
+        {
+            const auto &cqe = mRing.cqes[head & *mRing.cqMask];
+
+            auto &transfer = mTransfers[cqe.user_data];
+            transfer.result = cqe.res;
+            transfer.pending = false;
+        }
+
+        cqHead.store(head, std::memory_order_release);
+    }
+#endif // STREAMABLE_HAS_IO_URING
+};
+} // namespace hbann
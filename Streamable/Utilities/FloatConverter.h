@@ -0,0 +1,285 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "BitReader.h"
+#include "BitWriter.h"
+
+namespace hbann
+{
+/*
+    Lossy conversions of floating points to smaller representations:
+        - float16 (IEEE 754 half precision) uses F16C when it is available
+        - bfloat16 (the upper half of a float)
+        - N bits quantization over a [min, max] interval
+*/
+class FloatConverter
+{
+  public:
+    [[nodiscard]] static constexpr uint16_t ToFloat16(const float aValue) noexcept
+    {
+        const auto bits = std::bit_cast<uint32_t>(aValue);
+        const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+        const auto exponent = static_cast<int32_t>((bits >> 23) & 0xFF) - 127 + 15;
+        auto mantissa = bits & 0x007FFFFF;
+
+        // NaN and infinity
+        if (((bits >> 23) & 0xFF) == 0xFF)
+        {
+            return sign | 0x7C00 | (mantissa ? 0x0200 : 0);
+        }
+
+        // overflow to infinity
+        if (exponent >= 0x1F)
+        {
+            return sign | 0x7C00;
+        }
+
+        // subnormals or zero
+        if (exponent <= 0)
+        {
+            if (exponent < -10)
+            {
+                return sign;
+            }
+
+            mantissa |= 0x00800000;
+            const auto shift = static_cast<uint32_t>(14 - exponent);
+            const auto half = uint32_t(1) << (shift - 1);
+            const auto rest = mantissa & ((uint32_t(1) << shift) - 1);
+
+            auto result = mantissa >> shift;
+            // round to nearest even
+            if (rest > half || (rest == half && (result & 1)))
+            {
+                result++;
+            }
+
+            return sign | static_cast<uint16_t>(result);
+        }
+
+        auto result = static_cast<uint32_t>(exponent << 10) | (mantissa >> 13);
+        // round to nearest even, a carry into the exponent is still correct
+        const auto rest = mantissa & 0x1FFF;
+        if (rest > 0x1000 || (rest == 0x1000 && (result & 1)))
+        {
+            result++;
+        }
+
+        return sign | static_cast<uint16_t>(result);
+    }
+
+    // the double (or long double) is rounded once instead of to a float and then to a float16
+    template <std::floating_point Type>
+        requires(!std::is_same_v<Type, float>)
+    [[nodiscard]] static constexpr uint16_t ToFloat16(const Type aValue) noexcept
+    {
+        return ToFloat16(ToFloatRoundedToOdd(aValue));
+    }
+
+    [[nodiscard]] static constexpr float FromFloat16(const uint16_t aValue) noexcept
+    {
+        const auto sign = static_cast<uint32_t>(aValue & 0x8000) << 16;
+        auto exponent = static_cast<uint32_t>((aValue >> 10) & 0x1F);
+        auto mantissa = static_cast<uint32_t>(aValue & 0x03FF);
+
+        if (exponent == 0x1F)
+        {
+            return std::bit_cast<float>(sign | 0x7F800000 | (mantissa << 13));
+        }
+
+        if (!exponent)
+        {
+            if (!mantissa)
+            {
+                return std::bit_cast<float>(sign);
+            }
+
+            // normalize the subnormal
+            exponent = 1;
+            while (!(mantissa & 0x0400))
+            {
+                mantissa <<= 1;
+                exponent--;
+            }
+
+            mantissa &= 0x03FF;
+        }
+
+        return std::bit_cast<float>(sign | ((exponent + 127 - 15) << 23) | (mantissa << 13));
+    }
+
+    [[nodiscard]] static constexpr uint16_t ToBFloat16(const float aValue) noexcept
+    {
+        const auto bits = std::bit_cast<uint32_t>(aValue);
+
+        // keep NaNs quiet instead of rounding them to infinity
+        if ((bits & 0x7FFFFFFF) > 0x7F800000)
+        {
+            return static_cast<uint16_t>((bits >> 16) | 0x0040);
+        }
+
+        // round to nearest even
+        return static_cast<uint16_t>((bits + 0x7FFF + ((bits >> 16) & 1)) >> 16);
+    }
+
+    template <std::floating_point Type>
+        requires(!std::is_same_v<Type, float>)
+    [[nodiscard]] static constexpr uint16_t ToBFloat16(const Type aValue) noexcept
+    {
+        return ToBFloat16(ToFloatRoundedToOdd(aValue));
+    }
+
+    [[nodiscard]] static constexpr float FromBFloat16(const uint16_t aValue) noexcept
+    {
+        return std::bit_cast<float>(static_cast<uint32_t>(aValue) << 16);
+    }
+
+    template <std::floating_point Type>
+    static inline void ToFloat16(const std::span<const Type> aValues, const std::span<uint16_t> aHalfs) noexcept
+    {
+        assert(aValues.size() == aHalfs.size());
+
+        Size::size_max i{};
+#ifdef STREAMABLE_HAS_F16C
+        if constexpr (std::is_same_v<Type, float>)
+        {
+            for (; i + 8 <= aValues.size(); i += 8)
+            {
+                const auto floats = _mm256_loadu_ps(aValues.data() + i);
+                const auto halfs = _mm256_cvtps_ph(floats, _MM_FROUND_TO_NEAREST_INT);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(aHalfs.data() + i), halfs);
+            }
+        }
+#endif // STREAMABLE_HAS_F16C
+
+        for (; i < aValues.size(); i++)
+        {
+            aHalfs[i] = ToFloat16(aValues[i]);
+        }
+    }
+
+    template <std::floating_point Type>
+    static inline void FromFloat16(const std::span<const uint16_t> aHalfs, const std::span<Type> aValues) noexcept
+    {
+        assert(aValues.size() == aHalfs.size());
+
+        Size::size_max i{};
+#ifdef STREAMABLE_HAS_F16C
+        if constexpr (std::is_same_v<Type, float>)
+        {
+            for (; i + 8 <= aValues.size(); i += 8)
+            {
+                const auto halfs = _mm_loadu_si128(reinterpret_cast<const __m128i *>(aHalfs.data() + i));
+                _mm256_storeu_ps(aValues.data() + i, _mm256_cvtph_ps(halfs));
+            }
+        }
+#endif // STREAMABLE_HAS_F16C
+
+        for (; i < aValues.size(); i++)
+        {
+            aValues[i] = static_cast<Type>(FromFloat16(aHalfs[i]));
+        }
+    }
+
+    template <std::floating_point Type>
+    static constexpr void ToBFloat16(const std::span<const Type> aValues, const std::span<uint16_t> aHalfs) noexcept
+    {
+        assert(aValues.size() == aHalfs.size());
+
+        for (Size::size_max i = 0; i < aValues.size(); i++)
+        {
+            aHalfs[i] = ToBFloat16(aValues[i]);
+        }
+    }
+
+    template <std::floating_point Type>
+    static constexpr void FromBFloat16(const std::span<const uint16_t> aHalfs, const std::span<Type> aValues) noexcept
+    {
+        assert(aValues.size() == aHalfs.size());
+
+        for (Size::size_max i = 0; i < aValues.size(); i++)
+        {
+            aValues[i] = static_cast<Type>(FromBFloat16(aHalfs[i]));
+        }
+    }
+
+    // NaN is quantized to the first step (the min) because it has no place in the interval
+    [[nodiscard]] static constexpr uint64_t Quantize(const double aValue, const uint8_t aBits, const double aMin,
+                                                     const double aMax) noexcept
+    {
+        assert(aBits && aBits <= QUANTIZE_BITS_MAX && aMin < aMax);
+
+        if (aValue != aValue)
+        {
+            return 0;
+        }
+
+        const auto steps = static_cast<double>((uint64_t(1) << aBits) - 1);
+        const auto normalized = (std::clamp(aValue, aMin, aMax) - aMin) / (aMax - aMin);
+        return static_cast<uint64_t>(normalized * steps + 0.5);
+    }
+
+    [[nodiscard]] static constexpr double Dequantize(const uint64_t aValue, const uint8_t aBits, const double aMin,
+                                                     const double aMax) noexcept
+    {
+        assert(aBits && aBits <= QUANTIZE_BITS_MAX && aMin < aMax);
+
+        const auto steps = static_cast<double>((uint64_t(1) << aBits) - 1);
+        return aMin + static_cast<double>(aValue) * (aMax - aMin) / steps;
+    }
+
+    template <std::floating_point Type>
+    [[nodiscard]] static constexpr auto Quantize(const std::span<const Type> aValues, const uint8_t aBits,
+                                                 const double aMin, const double aMax)
+    {
+        BitWriter bitWriter;
+        bitWriter.Reserve((aValues.size() * aBits + 7) / 8);
+
+        for (const auto value : aValues)
+        {
+            bitWriter.Write(Quantize(value, aBits, aMin, aMax), aBits);
+        }
+
+        return bitWriter.Release();
+    }
+
+    template <std::floating_point Type>
+    static constexpr void Dequantize(const std::span<const uint8_t> aBytes, const std::span<Type> aValues,
+                                     const uint8_t aBits, const double aMin, const double aMax) noexcept
+    {
+        BitReader bitReader(aBytes);
+        for (auto &value : aValues)
+        {
+            value = static_cast<Type>(Dequantize(bitReader.Read(aBits), aBits, aMin, aMax));
+        }
+    }
+
+    static inline constexpr uint8_t QUANTIZE_BITS_MAX = 32;
+
+  private:
+    // the float is rounded to odd (the value truncated with the lowest bit set when bits were lost) so rounding it
+    // again to a smaller representation gives the same result as rounding the value once
+    template <std::floating_point Type>
+    [[nodiscard]] static constexpr float ToFloatRoundedToOdd(const Type aValue) noexcept
+    {
+        const auto value = static_cast<float>(aValue);
+        if (static_cast<Type>(value) == aValue || aValue != aValue)
+        {
+            return value;
+        }
+
+        auto bits = std::bit_cast<uint32_t>(value);
+        if (aValue > 0 ? static_cast<Type>(value) > aValue : static_cast<Type>(value) < aValue)
+        {
+            bits--;
+        }
+
+        return std::bit_cast<float>(bits | 1);
+    }
+};
+} // namespace hbann
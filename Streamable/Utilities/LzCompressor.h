@@ -0,0 +1,277 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "Size.h"
+
+namespace hbann
+{
+/*
+    Lossless compression of bytes (LZ4 like) that is made for speed over ratio, ex.:
+        std::vector<uint8_t> encoded;
+        ::hbann::LzCompressor::Encode(bytes, encoded);
+        ::hbann::LzCompressor::Decode(encoded, decoded); // decoded has the size of bytes
+
+    Format: sequences until the end of the encoded bytes, the last one has only literals:
+        - a token with the count of literals in the high 4 bits and the length of the match - 4 in the low 4 bits,
+          a count of 15 continues with bytes that are added to it until one is not 255
+        - the literals copied as they are
+        - the offset back to the match as 2 bytes little endian, the match can overlap the bytes it makes
+
+    The matches are found by the hash of the next 4 bytes in a table of the last positions with the same hash and the
+   bytes that don't match are skipped faster the longer they are so the incompressible ones are not slow.
+*/
+class LzCompressor
+{
+    using span = std::span<const uint8_t>;
+    using vector = std::vector<uint8_t>;
+
+  public:
+    static inline constexpr Size::size_max MATCH_MIN = 4;
+    static inline constexpr Size::size_max OFFSET_MAX = 0xFFFF;
+
+    // the size of the encoded bytes can't be bigger than this
+    [[nodiscard]] static constexpr Size::size_max GetBound(const Size::size_max aSize) noexcept
+    {
+        return aSize + aSize / 255 + 16;
+    }
+
+    // appends the encoded bytes
+    static void Encode(const span aBytes, vector &aEncoded)
+    {
+        assert(aBytes.size() <= std::numeric_limits<uint32_t>::max());
+
+        const auto offset = aEncoded.size();
+        aEncoded.resize(offset + GetBound(aBytes.size()));
+        auto encoded = aEncoded.data() + offset;
+
+        const auto bytes = aBytes.data();
+        const auto size = aBytes.size();
+
+        std::array<uint32_t, 1 << HASH_BITS> positions{};
+        Size::size_max anchor{};
+        for (Size::size_max i = 0; i + MATCH_MIN <= size;)
+        {
+            const auto value = Load<uint32_t>(bytes + i);
+            auto &position = positions[Hash(value)];
+            const Size::size_max candidate = std::exchange(position, static_cast<uint32_t>(i));
+
+            if (candidate >= i || i - candidate > OFFSET_MAX || Load<uint32_t>(bytes + candidate) != value)
+            {
+                i += 1 + ((i - anchor) >> SKIP_SHIFT);
+                continue;
+            }
+
+            // the match is extended forward and backward over the literals before it
+            const auto distance = i - candidate;
+            auto begin = i;
+            while (begin > anchor && begin > distance && bytes[begin - 1] == bytes[begin - 1 - distance])
+            {
+                begin--;
+            }
+
+            const auto end = i + MATCH_MIN + CountEqual(bytes + i + MATCH_MIN, bytes + candidate + MATCH_MIN,
+                                                        size - i - MATCH_MIN);
+
+            encoded = WriteSequence(encoded, {bytes + anchor, begin - anchor}, distance, end - begin);
+
+            // a position inside the match is remembered too for the matches that start in it
+            if (end + MATCH_MIN <= size + 2)
+            {
+                positions[Hash(Load<uint32_t>(bytes + end - 2))] = static_cast<uint32_t>(end - 2);
+            }
+
+            anchor = i = end;
+        }
+
+        encoded = WriteSequence(encoded, {bytes + anchor, size - anchor}, 0, 0);
+        aEncoded.resize(static_cast<Size::size_max>(encoded - aEncoded.data()));
+    }
+
+    // decodes the bytes into the decoded ones that must have the size of the bytes encoded, returns false when the
+    // encoded bytes are corrupted
+    [[nodiscard]] static bool Decode(const span aEncoded, const std::span<uint8_t> aDecoded) noexcept
+    {
+        Size::size_max in{};
+        Size::size_max out{};
+
+        const auto readLength = [&](Size::size_max &aLength) {
+            if (aLength != 15)
+            {
+                return true;
+            }
+
+            for (uint8_t byte = 255; byte == 255; aLength += byte)
+            {
+                if (in == aEncoded.size())
+                {
+                    return false;
+                }
+
+                byte = aEncoded[in++];
+            }
+
+            return true;
+        };
+
+        while (in < aEncoded.size())
+        {
+            const auto token = aEncoded[in++];
+
+            // the short literals and matches are copied with a fixed size when there is room after them, the bytes
+            // copied after them are overwritten by the next ones
+            Size::size_max literals = token >> 4;
+            if (literals < 15 && aEncoded.size() - in >= COPY_SIZE && aDecoded.size() - out >= COPY_SIZE)
+            {
+                std::memcpy(aDecoded.data() + out, aEncoded.data() + in, COPY_SIZE);
+            }
+            else if (!readLength(literals) || literals > aEncoded.size() - in || literals > aDecoded.size() - out)
+            {
+                return false;
+            }
+            else if (literals)
+            {
+                std::memcpy(aDecoded.data() + out, aEncoded.data() + in, literals);
+            }
+
+            in += literals;
+            out += literals;
+
+            if (in == aEncoded.size())
+            {
+                break;
+            }
+
+            if (aEncoded.size() - in < 2)
+            {
+                return false;
+            }
+
+            const Size::size_max distance = aEncoded[in] | (aEncoded[in + 1] << 8);
+            in += 2;
+
+            Size::size_max length = token & 15;
+            if (!readLength(length) || !distance || distance > out || length + MATCH_MIN > aDecoded.size() - out)
+            {
+                return false;
+            }
+
+            length += MATCH_MIN;
+            if (length <= COPY_SIZE + 2 && distance >= sizeof(uint64_t) && aDecoded.size() - out >= COPY_SIZE + 8)
+            {
+                for (Size::size_max i = 0; i < length; i += sizeof(uint64_t))
+                {
+                    std::memcpy(aDecoded.data() + out + i, aDecoded.data() + out + i - distance, sizeof(uint64_t));
+                }
+
+                out += length;
+                continue;
+            }
+
+            // the overlapping match repeats the bytes at its distance so they are copied a distance at a time
+            while (length)
+            {
+                const auto count = std::min(length, distance);
+                std::memcpy(aDecoded.data() + out, aDecoded.data() + out - distance, count);
+
+                out += count;
+                length -= count;
+            }
+        }
+
+        return out == aDecoded.size();
+    }
+
+  private:
+    static inline constexpr size_t HASH_BITS = 13;
+    static inline constexpr size_t SKIP_SHIFT = 6;
+    static inline constexpr Size::size_max COPY_SIZE = 16;
+
+    template <typename Type> [[nodiscard]] static inline Type Load(const uint8_t *aBytes) noexcept
+    {
+        Type value{};
+        std::memcpy(&value, aBytes, sizeof(value));
+
+        return value;
+    }
+
+    [[nodiscard]] static constexpr size_t Hash(const uint32_t aValue) noexcept
+    {
+        return (aValue * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    // the count of the bytes that are equal at the start of both (8 at a time)
+    [[nodiscard]] static inline Size::size_max CountEqual(const uint8_t *aBytes, const uint8_t *aMatch,
+                                                          const Size::size_max aSize) noexcept
+    {
+        Size::size_max count{};
+        for (; count + sizeof(uint64_t) <= aSize; count += sizeof(uint64_t))
+        {
+            if (const auto difference = Load<uint64_t>(aBytes + count) ^ Load<uint64_t>(aMatch + count); difference)
+            {
+                const auto bits = std::endian::native == std::endian::little ? std::countr_zero(difference)
+                                                                               : std::countl_zero(difference);
+                return count + static_cast<Size::size_max>(bits) / 8;
+            }
+        }
+
+        while (count < aSize && aBytes[count] == aMatch[count])
+        {
+            count++;
+        }
+
+        return count;
+    }
+
+    [[nodiscard]] static inline uint8_t *WriteLength(uint8_t *aEncoded, Size::size_max aLength) noexcept
+    {
+        for (; aLength >= 255; aLength -= 255)
+        {
+            *aEncoded++ = 255;
+        }
+
+        *aEncoded++ = static_cast<uint8_t>(aLength);
+        return aEncoded;
+    }
+
+    // writes the literals followed by the match when it has a length
+    [[nodiscard]] static inline uint8_t *WriteSequence(uint8_t *aEncoded, const span aLiterals,
+                                                       const Size::size_max aDistance,
+                                                       const Size::size_max aLength) noexcept
+    {
+        const auto length = aLength ? aLength - MATCH_MIN : 0;
+        *aEncoded++ = static_cast<uint8_t>((std::min<Size::size_max>(aLiterals.size(), 15) << 4) |
+                                           std::min<Size::size_max>(length, 15));
+
+        if (aLiterals.size() >= 15)
+        {
+            aEncoded = WriteLength(aEncoded, aLiterals.size() - 15);
+        }
+
+        if (!aLiterals.empty())
+        {
+            std::memcpy(aEncoded, aLiterals.data(), aLiterals.size());
+            aEncoded += aLiterals.size();
+        }
+
+        if (!aLength)
+        {
+            return aEncoded;
+        }
+
+        *aEncoded++ = static_cast<uint8_t>(aDistance);
+        *aEncoded++ = static_cast<uint8_t>(aDistance >> 8);
+
+        if (length >= 15)
+        {
+            aEncoded = WriteLength(aEncoded, length - 15);
+        }
+
+        return aEncoded;
+    }
+};
+} // namespace hbann
@@ -17,6 +17,8 @@ namespace hbann
    written at the most left side of the 1-8 bytes.
 
     The actual size is written to the left most side of the 1-8 bytes.
+
+    This is the default size policy, see SizeFixed and SizeVarint for the others.
 */
 class Size
 {
@@ -24,110 +26,71 @@ class Size
     using size_max = size_t; // size_t / (4/8)
     using span = std::span<const uint8_t>;
 
-    [[nodiscard]] static constexpr auto FindRequiredBytes(const uint8_t aSize) noexcept
+    // The bytes of an encoded size, it is returned by value so nothing is shared between calls or threads
+    struct bytes
     {
-        if constexpr (SIZE_MAX_IN_BYTES == 4)
-        {
-            return static_cast<size_max>(aSize >> 6);
-        }
-        else
+        std::array<uint8_t, sizeof(size_max) + 1> data{};
+        uint8_t count{};
+
+        [[nodiscard]] constexpr operator span() const noexcept
         {
-            return static_cast<size_max>(aSize >> 5);
+            return {data.data(), count};
         }
+    };
+
+    // 0 means the size has a variable length and its first byte must be read to find it
+    static inline constexpr size_max BYTES_FIXED = 0;
+
+    [[nodiscard]] static constexpr auto FindRequiredBytes(const uint8_t aSize) noexcept
+    {
+        return static_cast<size_max>(aSize >> (8 - BITS_REQUIRED_BYTES));
     }
 
     [[nodiscard]] static constexpr size_max FindRequiredBytes(const size_max aSize) noexcept
     {
-        size_max requiredBits{1};
-        if (aSize)
-        {
-            // add the bits required to represent the size
-            requiredBits += static_cast<size_max>(std::log2(aSize));
-        }
-
-        // add the bits required to represent the required bytes to store the final value
-        if constexpr (SIZE_MAX_IN_BYTES == 4)
-        {
-            requiredBits += 2;
-        }
-        else
-        {
-            requiredBits += 3;
-        }
+        // the bits required to represent the size (at least 1) and the bits that store the required bytes
+        const auto requiredBits = std::max<size_max>(std::bit_width(aSize), 1) + BITS_REQUIRED_BYTES;
 
         // add 7 bits to round the final value up
         return (requiredBits + 7) / 8;
     }
 
-    [[nodiscard]] static inline auto MakeSize(const size_max aSize) noexcept
+    [[nodiscard]] static constexpr bytes MakeSize(const size_max aSize) noexcept
     {
-        thread_local uint8_t SIZE_AS_CHARS[SIZE_MAX_IN_BYTES]{};
-        auto &SIZE = *reinterpret_cast<size_max *>(SIZE_AS_CHARS);
-
         const auto requiredBytes = FindRequiredBytes(aSize);
-        auto SIZE_AS_CHARS_START = SIZE_AS_CHARS + (SIZE_MAX_IN_BYTES - requiredBytes);
 
-        // write the size itself
-        SIZE = ToBigEndian(aSize);
-        // write the 3 bits representing the bytes required
-        if constexpr (SIZE_MAX_IN_BYTES == 4)
+        // write the last 'requiredBytes' of the size as big endian
+        bytes sizeBytes{.count = static_cast<uint8_t>(requiredBytes)};
+        for (size_max i = 0; i < requiredBytes; i++)
         {
-            *SIZE_AS_CHARS_START |= requiredBytes << 6;
-        }
-        else
-        {
-            *SIZE_AS_CHARS_START |= requiredBytes << 5;
+            sizeBytes.data[i] = static_cast<uint8_t>(aSize >> (8 * (requiredBytes - 1 - i)));
         }
 
-        // return the last 'requiredBytes' from SIZE
-        return span{SIZE_AS_CHARS_START, requiredBytes};
+        // write the bits representing the bytes required
+        sizeBytes.data[0] |= static_cast<uint8_t>(requiredBytes << (8 - BITS_REQUIRED_BYTES));
+
+        return sizeBytes;
     }
 
-    [[nodiscard]] static inline auto MakeSize(const span aSize) noexcept
+    [[nodiscard]] static constexpr size_max MakeSize(const uint8_t aFirst, const span aRest) noexcept
     {
-        uint8_t SIZE_AS_CHARS[SIZE_MAX_IN_BYTES]{};
-        auto &SIZE = *reinterpret_cast<size_max *>(SIZE_AS_CHARS);
-
-        size_max requiredBytes{};
-        if constexpr (SIZE_MAX_IN_BYTES == 4)
-        {
-            requiredBytes = static_cast<size_max>(aSize.front() >> 6);
-        }
-        else
-        {
-            requiredBytes = static_cast<size_max>(aSize.front() >> 5);
-        }
-
-        auto SIZE_AS_CHARS_START = SIZE_AS_CHARS + (SIZE_MAX_IN_BYTES - requiredBytes);
-        // copy only the resizeable size
-        std::memcpy(SIZE_AS_CHARS_START, aSize.data(), requiredBytes);
-
         // clear the required bytes
-        if constexpr (SIZE_MAX_IN_BYTES == 4)
+        auto size = static_cast<size_max>(aFirst & (0xFF >> BITS_REQUIRED_BYTES));
+        for (const auto byte : aRest)
         {
-            *SIZE_AS_CHARS_START &= 0b00111111;
-        }
-        else
-        {
-            *SIZE_AS_CHARS_START &= 0b00011111;
+            size = (size << 8) | byte;
         }
 
-        return ToBigEndian(SIZE);
+        return size;
     }
 
-  private:
-    static inline constexpr auto SIZE_MAX_IN_BYTES = sizeof(size_max);
-
-    [[nodiscard]] static constexpr size_max ToBigEndian(const size_max aSize) noexcept
+    [[nodiscard]] static constexpr size_max MakeSize(const span aSize) noexcept
     {
-        if constexpr (std::endian::native == std::endian::little)
-        {
-            return ByteSwap(aSize);
-        }
-        else
-        {
-            return aSize;
-        }
+        return aSize.empty() ? 0 : MakeSize(aSize.front(), aSize.subspan(1));
     }
+
+  private:
+    static inline constexpr auto SIZE_MAX_IN_BYTES = sizeof(size_max);
+    static inline constexpr size_max BITS_REQUIRED_BYTES = SIZE_MAX_IN_BYTES == 4 ? 2 : 3;
 };
 } // namespace hbann
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "Reflector.h"
 #include "Size.h"
 
 namespace hbann
@@ -13,6 +14,33 @@ namespace hbann
 class SizeFinder
 {
   public:
+    // the objects of known size are copied together into a buffer on the stack up to this size
+    static inline constexpr Size::size_max OBJECTS_OF_KNOWN_SIZE_MAX = 1024;
+
+    // the size of the serialized type when it is bounded, it is exact when the type has always the same size
+    struct serialized_size
+    {
+        Size::size_max max{};
+        bool bounded{};
+        bool exact{};
+    };
+
+    // the size written by Serialize for the streamables and by the StreamWriter for the rest of the types
+    template <typename Type, typename SizeType>
+    [[nodiscard]] static consteval serialized_size FindSerializedSize() noexcept
+    {
+        using TypeRaw = std::remove_cvref_t<Type>;
+
+        if constexpr (std::derived_from<TypeRaw, IStreamable> || is_static_streamable<TypeRaw>)
+        {
+            return FindStreamableSize<TypeRaw, SizeType>();
+        }
+        else
+        {
+            return FindObjectSize<TypeRaw, SizeType>();
+        }
+    }
+
     template <typename Type> [[nodiscard]] static consteval Size::size_max FindRangeRank() noexcept
     {
         using TypeRaw = std::remove_cvref_t<Type>;
@@ -27,6 +55,40 @@ class SizeFinder
         }
     }
 
+    // the count of the leading objects of known size that fit together in OBJECTS_OF_KNOWN_SIZE_MAX, the bigger ones
+    // are written on their own
+    template <typename... Types> [[nodiscard]] static consteval size_t FindObjectsOfKnownSizeCount() noexcept
+    {
+        size_t count{};
+        Size::size_max size{};
+        for (const auto &[isObjectOfKnownSize, sizeObject] :
+             {std::pair{is_object_of_known_size<std::remove_cvref_t<Types>>, sizeof(std::remove_cvref_t<Types>)}...})
+        {
+            if (!isObjectOfKnownSize || size + sizeObject > OBJECTS_OF_KNOWN_SIZE_MAX)
+            {
+                break;
+            }
+
+            count++;
+            size += sizeObject;
+        }
+
+        return count;
+    }
+
+    // the offsets of the objects of known size written one after another, the last one is their size
+    template <typename Tuple> [[nodiscard]] static consteval auto FindObjectsOfKnownSizeOffsets() noexcept
+    {
+        return []<typename... Types>(std::type_identity<std::tuple<Types...>>) {
+            std::array<Size::size_max, sizeof...(Types) + 1> offsets{};
+
+            size_t index{};
+            ((offsets[index + 1] = offsets[index] + sizeof(Types), index++), ...);
+
+            return offsets;
+        }(std::type_identity<Tuple>{});
+    }
+
     template <std::ranges::range Range>
     [[nodiscard]] static constexpr Size::size_max GetRangeCount(const Range &aRange) noexcept
     {
@@ -45,5 +107,158 @@ class SizeFinder
             static_assert(always_false<RangeRaw>, "Tried to get the range count from an unknown object!");
         }
     }
+
+  private:
+    template <typename SizeType>
+    [[nodiscard]] static consteval Size::size_max FindCountSize(const Size::size_max aCount) noexcept
+    {
+        return SizeType::FindRequiredBytes(aCount);
+    }
+
+    // the size of the objects written one after another
+    [[nodiscard]] static consteval serialized_size SumSizes(
+        const std::initializer_list<serialized_size> aSizes) noexcept
+    {
+        serialized_size size{.bounded = true, .exact = true};
+        for (const auto &sizeObject : aSizes)
+        {
+            size.max += sizeObject.max;
+            size.bounded &= sizeObject.bounded;
+            size.exact &= sizeObject.exact;
+        }
+
+        return size.bounded ? size : serialized_size{};
+    }
+
+    // the fields of the bases and of the streamable as written by ToStream
+    template <typename Type, typename SizeType>
+    [[nodiscard]] static consteval serialized_size FindStreamableSize() noexcept
+    {
+        using TypeFields = decltype(std::declval<Type &>().StreamableApply(
+            [](auto &&...aFields) { return std::tuple<std::remove_cvref_t<decltype(aFields)>...>{}; }));
+
+        const auto sizeFields = []<typename... Fields>(std::type_identity<std::tuple<Fields...>>) {
+            return SumSizes({FindObjectSize<Fields, SizeType>()...});
+        }(std::type_identity<TypeFields>{});
+
+        if constexpr (requires { typename Type::streamable_bases; })
+        {
+            const auto sizeBases = []<typename... Bases>(std::type_identity<std::tuple<Bases...>>) {
+                return SumSizes({FindStreamableSize<Bases, SizeType>()...});
+            }(std::type_identity<typename Type::streamable_bases>{});
+
+            return SumSizes({sizeBases, sizeFields});
+        }
+        else
+        {
+            return sizeFields;
+        }
+    }
+
+    // mirrors the branches of the StreamWriter::Write
+    template <typename Type, typename SizeType>
+    [[nodiscard]] static consteval serialized_size FindObjectSize() noexcept
+    {
+        if constexpr (is_attribute<Type> || is_any_pointer<Type>)
+        {
+            return {};
+        }
+        else if constexpr (is_optional_v<Type>)
+        {
+            const auto size = FindObjectSize<typename Type::value_type, SizeType>();
+            return size.bounded ? serialized_size{FindCountSize<SizeType>(1) + size.max, true, false} : size;
+        }
+        else if constexpr (is_variant_v<Type>)
+        {
+            return []<typename... Types>(std::type_identity<std::variant<Types...>>) {
+                constexpr serialized_size sizes[]{FindObjectSize<Types, SizeType>()...};
+
+                // the index and the alternatives must have the same size for an exact size
+                const auto countSize = FindCountSize<SizeType>(sizeof...(Types) - 1);
+                serialized_size size{.bounded = true, .exact = countSize == FindCountSize<SizeType>(0)};
+                for (const auto &sizeType : sizes)
+                {
+                    size.bounded &= sizeType.bounded;
+                    size.exact &= sizeType.exact && sizeType.max == sizes[0].max;
+                    size.max = std::max(size.max, sizeType.max);
+                }
+
+                return size.bounded ? serialized_size{countSize + size.max, true, size.exact} : serialized_size{};
+            }(std::type_identity<Type>{});
+        }
+        else if constexpr (is_tuple_v<Type>)
+        {
+            return []<typename... Types>(std::type_identity<std::tuple<Types...>>) {
+                return SumSizes({FindObjectSize<Types, SizeType>()...});
+            }(std::type_identity<Type>{});
+        }
+        else if constexpr (is_pair_v<Type>)
+        {
+            return SumSizes({FindObjectSize<std::remove_const_t<typename Type::first_type>, SizeType>(),
+                             FindObjectSize<typename Type::second_type, SizeType>()});
+        }
+        else if constexpr (is_array_v<Type>)
+        {
+            constexpr auto count = std::tuple_size_v<Type>;
+            if constexpr ((FindRangeRank<Type>() == 1 && is_range_standard_layout<Type>) ||
+                          is_range_of_arrays_of_known_size<Type>)
+            {
+                return {FindCountSize<SizeType>(count) + sizeof(Type), true, true};
+            }
+            else
+            {
+                const auto size = FindObjectSize<typename Type::value_type, SizeType>();
+                return size.bounded
+                           ? serialized_size{FindCountSize<SizeType>(count) + count * size.max, true, size.exact}
+                           : size;
+            }
+        }
+        else if constexpr (std::ranges::range<Type>)
+        {
+            return {};
+        }
+        else if constexpr (std::derived_from<Type, IStreamable> || is_static_streamable<Type>)
+        {
+            // the streamables are written as size + bytes
+            const auto size = FindStreamableSize<Type, SizeType>();
+            return size.bounded ? serialized_size{FindCountSize<SizeType>(size.max) + size.max, true, size.exact}
+                                : size;
+        }
+        else if constexpr (is_reflectable_aggregate<Type>)
+        {
+            // the aggregates are written field by field
+            using TypeFields = decltype(Reflector::Apply(
+                std::declval<Type &>(),
+                [](auto &&...aFields) { return std::tuple<std::remove_cvref_t<decltype(aFields)>...>{}; }));
+
+            return []<typename... Fields>(std::type_identity<std::tuple<Fields...>>) {
+                return SumSizes({FindObjectSize<Fields, SizeType>()...});
+            }(std::type_identity<TypeFields>{});
+        }
+        else if constexpr (is_standard_layout_no_pointer<Type>)
+        {
+            return {sizeof(Type), true, true};
+        }
+        else
+        {
+            return {};
+        }
+    }
 };
+
+// the types with an upper bound for their serialized size
+template <typename Type, typename SizeType = STREAMABLE_SIZE_TYPE>
+concept is_serialized_size_bounded = SizeFinder::FindSerializedSize<Type, SizeType>().bounded;
+
+// the types that are always serialized in the same number of bytes
+template <typename Type, typename SizeType = STREAMABLE_SIZE_TYPE>
+concept is_serialized_size_exact = SizeFinder::FindSerializedSize<Type, SizeType>().exact;
+
+template <typename Type, typename SizeType = STREAMABLE_SIZE_TYPE>
+    requires is_serialized_size_bounded<Type, SizeType>
+inline constexpr Size::size_max max_serialized_size = SizeFinder::FindSerializedSize<Type, SizeType>().max;
+
+template <typename Type, typename SizeType = STREAMABLE_SIZE_TYPE>
+    requires is_serialized_size_exact<Type, SizeType>
+inline constexpr Size::size_max exact_serialized_size = SizeFinder::FindSerializedSize<Type, SizeType>().max;
 } // namespace hbann
@@ -0,0 +1,70 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "Size.h"
+
+namespace hbann
+{
+/*
+    Format: always 4 bytes little endian (the sizes bigger than 4GB can't be written)
+
+    Trades bytes for cycles, there are no branches when writing or reading a size so it fits in-memory IPC.
+*/
+class SizeFixed
+{
+  public:
+    using size_max = Size::size_max;
+    using span = Size::span;
+    using bytes = Size::bytes;
+
+    static inline constexpr size_max BYTES_FIXED = sizeof(uint32_t);
+
+    [[nodiscard]] static constexpr size_max FindRequiredBytes(const uint8_t) noexcept
+    {
+        return BYTES_FIXED;
+    }
+
+    [[nodiscard]] static constexpr size_max FindRequiredBytes(const size_max) noexcept
+    {
+        return BYTES_FIXED;
+    }
+
+    // the sizes that don't fit in 4 bytes can't be written so they throw
+    [[nodiscard]] static constexpr bytes MakeSize(const size_max aSize)
+    {
+        if (aSize > UINT32_MAX)
+        {
+            throw std::length_error("The size doesn't fit in 4 bytes!");
+        }
+
+        bytes sizeBytes{.count = static_cast<uint8_t>(BYTES_FIXED)};
+        for (size_max i = 0; i < BYTES_FIXED; i++)
+        {
+            sizeBytes.data[i] = static_cast<uint8_t>(aSize >> (8 * i));
+        }
+
+        return sizeBytes;
+    }
+
+    [[nodiscard]] static constexpr size_max MakeSize(const uint8_t aFirst, const span aRest) noexcept
+    {
+        size_max size = aFirst;
+        for (size_max i = 0; i < aRest.size() && i < BYTES_FIXED - 1; i++)
+        {
+            size |= static_cast<size_max>(aRest[i]) << (8 * (i + 1));
+        }
+
+        return size;
+    }
+
+    [[nodiscard]] static constexpr size_max MakeSize(const span aSize) noexcept
+    {
+        return aSize.empty() ? 0 : MakeSize(aSize.front(), aSize.subspan(1));
+    }
+};
+} // namespace hbann
@@ -0,0 +1,85 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "Size.h"
+
+namespace hbann
+{
+/*
+    Format: prefix varint of 1-9 bytes
+
+    The count of the leading 1 bits of the first byte is the count of the bytes that follow it, the size is written
+   big endian after the first 0 bit, so 0-127 takes a single byte and the 9 bytes form (0xFF) holds a whole size_max.
+
+        0xxxxxxx                     0 - 2^7 - 1
+        10xxxxxx xxxxxxxx            0 - 2^14 - 1
+        ...
+        11111111 8 bytes             0 - 2^64 - 1
+*/
+class SizeVarint
+{
+  public:
+    using size_max = Size::size_max;
+    using span = Size::span;
+    using bytes = Size::bytes;
+
+    static inline constexpr size_max BYTES_FIXED = 0;
+
+    [[nodiscard]] static constexpr size_max FindRequiredBytes(const uint8_t aSize) noexcept
+    {
+        return static_cast<size_max>(std::countl_one(aSize)) + 1;
+    }
+
+    [[nodiscard]] static constexpr size_max FindRequiredBytes(const size_max aSize) noexcept
+    {
+        // every byte but the 9th holds 7 bits
+        const auto requiredBytes = std::max<size_max>((std::bit_width(aSize) + 6) / 7, 1);
+        return requiredBytes <= 8 ? requiredBytes : 9;
+    }
+
+    [[nodiscard]] static constexpr bytes MakeSize(const size_max aSize) noexcept
+    {
+        const auto requiredBytes = FindRequiredBytes(aSize);
+
+        bytes sizeBytes{.count = static_cast<uint8_t>(requiredBytes)};
+        if (requiredBytes == 1)
+        {
+            sizeBytes.data[0] = static_cast<uint8_t>(aSize);
+            return sizeBytes;
+        }
+
+        // the 9 bytes form has the whole first byte as prefix
+        const auto offset = requiredBytes == 9 ? 1 : 0;
+        for (size_max i = offset; i < requiredBytes; i++)
+        {
+            sizeBytes.data[i] = static_cast<uint8_t>(aSize >> (8 * (requiredBytes - 1 - i)));
+        }
+
+        sizeBytes.data[0] |= static_cast<uint8_t>(0xFF00 >> (requiredBytes - 1));
+
+        return sizeBytes;
+    }
+
+    [[nodiscard]] static constexpr size_max MakeSize(const uint8_t aFirst, const span aRest) noexcept
+    {
+        // clear the prefix
+        auto size = static_cast<size_max>(aFirst & (0xFF >> FindRequiredBytes(aFirst)));
+        for (const auto byte : aRest)
+        {
+            size = (size << 8) | byte;
+        }
+
+        return size;
+    }
+
+    [[nodiscard]] static constexpr size_max MakeSize(const span aSize) noexcept
+    {
+        return aSize.empty() ? 0 : MakeSize(aSize.front(), aSize.subspan(1));
+    }
+};
+} // namespace hbann
@@ -0,0 +1,158 @@
+/*
+    Copyright (c) 2024 Claudiu HBann
+
+    See LICENSE for the full terms of the MIT License.
+*/
+
+#pragma once
+
+#include "BitReader.h"
+#include "BitWriter.h"
+
+namespace hbann
+{
+/*
+    Lossless compression of floating point series (Gorilla like)
+
+    Format: the first value as is, then every value is XOR-ed with the previous one and written as:
+        - '0'                                   when it is equal to the previous value
+        - '10' + meaningful bits                when its meaningful bits fit in the previous leading/trailing window
+        - '11' + leading + length + meaningful  otherwise
+
+    Slowly changing series have a lot of leading and trailing zeros after the XOR so most values take a few bits.
+*/
+class XorCompressor
+{
+    using span = std::span<const uint8_t>;
+    using vector = std::vector<uint8_t>;
+
+  public:
+    template <std::floating_point Type>
+    [[nodiscard]] static constexpr vector Encode(const std::span<const Type> aValues)
+    {
+        using TypeBits = bits_t<Type>;
+        static_assert(sizeof(Type) == sizeof(TypeBits), "Type must be a float or a double!");
+
+        BitWriter bitWriter;
+        // most series compress at least 2 times so we don't reserve the whole size
+        bitWriter.Reserve(aValues.size_bytes() / 2);
+
+        TypeBits previous{};
+        uint8_t previousLeading = BITS_TOTAL<Type> + 1; // no window yet
+        uint8_t previousTrailing{};
+
+        for (Size::size_max i = 0; i < aValues.size(); i++)
+        {
+            const auto bits = std::bit_cast<TypeBits>(aValues[i]);
+            if (!i)
+            {
+                bitWriter.Write(bits, BITS_TOTAL<Type>);
+                previous = bits;
+                continue;
+            }
+
+            const auto xored = bits ^ previous;
+            previous = bits;
+
+            if (!xored)
+            {
+                bitWriter.WriteBit(false);
+                continue;
+            }
+
+            bitWriter.WriteBit(true);
+
+            auto leading = static_cast<uint8_t>(std::countl_zero(xored));
+            const auto trailing = static_cast<uint8_t>(std::countr_zero(xored));
+
+            if (leading >= previousLeading && trailing >= previousTrailing &&
+                previousLeading <= BITS_TOTAL<Type>)
+            {
+                // reuse the previous window
+                bitWriter.WriteBit(false);
+                bitWriter.Write(xored >> previousTrailing,
+                                static_cast<uint8_t>(BITS_TOTAL<Type> - previousLeading - previousTrailing));
+            }
+            else
+            {
+                // the leading zeros count must fit in its field
+                leading = std::min(leading, BITS_LEADING_MAX<Type>);
+                const auto length = static_cast<uint8_t>(BITS_TOTAL<Type> - leading - trailing);
+
+                bitWriter.WriteBit(true);
+                bitWriter.Write(leading, BITS_LEADING<Type>);
+                bitWriter.Write(length - 1, BITS_LENGTH<Type>); // length is [1, BITS_TOTAL]
+                bitWriter.Write(xored >> trailing, length);
+
+                previousLeading = leading;
+                previousTrailing = trailing;
+            }
+        }
+
+        return bitWriter.Release();
+    }
+
+    // decodes the values until a corrupted window (ex.: more meaningful bits than the type has), returns the count of
+    // the values decoded
+    template <std::floating_point Type>
+    [[nodiscard]] static constexpr Size::size_max Decode(const span aBytes, const std::span<Type> aValues)
+    {
+        using TypeBits = bits_t<Type>;
+        static_assert(sizeof(Type) == sizeof(TypeBits), "Type must be a float or a double!");
+
+        if (aValues.empty())
+        {
+            return 0;
+        }
+
+        BitReader bitReader(aBytes);
+
+        auto previous = static_cast<TypeBits>(bitReader.Read(BITS_TOTAL<Type>));
+        aValues.front() = std::bit_cast<Type>(previous);
+
+        uint8_t leading{};
+        uint8_t trailing{};
+
+        for (Size::size_max i = 1; i < aValues.size(); i++)
+        {
+            if (bitReader.ReadBit())
+            {
+                if (bitReader.ReadBit())
+                {
+                    leading = static_cast<uint8_t>(bitReader.Read(BITS_LEADING<Type>));
+                    const auto length = static_cast<uint8_t>(bitReader.Read(BITS_LENGTH<Type>) + 1);
+                    if (leading + length > BITS_TOTAL<Type>)
+                    {
+                        return i;
+                    }
+
+                    trailing = static_cast<uint8_t>(BITS_TOTAL<Type> - leading - length);
+                }
+
+                const auto length = static_cast<uint8_t>(BITS_TOTAL<Type> - leading - trailing);
+                previous ^= static_cast<TypeBits>(bitReader.Read(length) << trailing);
+            }
+
+            aValues[i] = std::bit_cast<Type>(previous);
+        }
+
+        return aValues.size();
+    }
+
+  private:
+    template <std::floating_point Type>
+    using bits_t = std::conditional_t<sizeof(Type) == sizeof(uint64_t), uint64_t, uint32_t>;
+
+    template <std::floating_point Type>
+    static inline constexpr uint8_t BITS_TOTAL = static_cast<uint8_t>(sizeof(bits_t<Type>) * 8);
+
+    // the leading zeros and the meaningful bits count field widths
+    template <std::floating_point Type>
+    static inline constexpr uint8_t BITS_LEADING = sizeof(bits_t<Type>) == sizeof(uint64_t) ? 5 : 4;
+    template <std::floating_point Type>
+    static inline constexpr uint8_t BITS_LENGTH = sizeof(bits_t<Type>) == sizeof(uint64_t) ? 6 : 5;
+
+    template <std::floating_point Type>
+    static inline constexpr uint8_t BITS_LEADING_MAX = static_cast<uint8_t>((1 << BITS_LEADING<Type>) - 1);
+};
+} // namespace hbann
@@ -31,19 +31,89 @@
 
 #else
 #warning "Platform does not support encoding UTF16 strings to save memory!"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
 #endif
 
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define STREAMABLE_HAS_IO_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif // __linux__ && __has_include(<linux/io_uring.h>)
+
+#ifdef __linux__
+#define STREAMABLE_HAS_SENDFILE
+#include <sys/sendfile.h>
+#endif // __linux__
+
+// intrinsics
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define STREAMABLE_HAS_F16C
+#include <immintrin.h>
+#endif // __F16C__ || (_MSC_VER && __AVX2__)
+
+#if defined(__SSSE3__) || (defined(_MSC_VER) && defined(__AVX__))
+#define STREAMABLE_HAS_SSSE3
+#include <immintrin.h>
+#endif // __SSSE3__ || (_MSC_VER && __AVX__)
+
+#if defined(__SSE4_2__) || (defined(_MSC_VER) && defined(__AVX__))
+#define STREAMABLE_HAS_SSE42
+#include <nmmintrin.h>
+#endif // __SSE4_2__ || (_MSC_VER && __AVX__)
+
+#ifdef __ARM_FEATURE_CRC32
+#define STREAMABLE_HAS_ARM_CRC32
+#include <arm_acle.h>
+#endif // __ARM_FEATURE_CRC32
+
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+#define STREAMABLE_HAS_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON || _M_ARM64
+
+// compression libraries (opt in, they must be linked)
+#if defined(STREAMABLE_USE_ZSTD) && __has_include(<zstd.h>)
+#define STREAMABLE_HAS_ZSTD
+#include <zstd.h>
+#endif // STREAMABLE_USE_ZSTD && __has_include(<zstd.h>)
+
+#if defined(STREAMABLE_USE_LZ4) && __has_include(<lz4.h>)
+#define STREAMABLE_HAS_LZ4
+#include <lz4.h>
+#endif // STREAMABLE_USE_LZ4 && __has_include(<lz4.h>)
+
 // std
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <bit>
 #include <cassert>
+#include <cerrno>
 #include <cmath>
+#include <condition_variable>
 #include <cstring>
+#include <exception>
 #include <filesystem>
 #include <fstream>
+#include <initializer_list>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -121,11 +191,27 @@
     STATIC_ASSERT_HAS_ISTREAMABLE_BASE(__VA_ARGS__)                                                                    \
     STATIC_ASSERT_DONT_PASS_ISTREAMABLE_AS_BASE(__VA_ARGS__)                                                           \
                                                                                                                        \
+  protected:                                                                                                           \
+    using streamable_bases = std::tuple<__VA_ARGS__>;                                                                  \
+                                                                                                                       \
     STREAMABLE_DEFINE_TO_STREAM_BASES(__VA_ARGS__)                                                                     \
     STREAMABLE_DEFINE_FROM_STREAM_BASES(__VA_ARGS__)                                                                   \
                                                                                                                        \
     STREAMABLE_RESET_ACCESS_MODIFIER
 
+#define STATIC_ASSERT_HAS_STATIC_STREAMABLE_BASE(...)                                                                  \
+    static_assert(::hbann::are_derived_from_static_streamable<__VA_ARGS__>,                                            \
+                  "The class must inherit a static streamable!");
+
+/* Like STREAMABLE_DEFINE_BASE for the static streamables, the bases are found at compile time */
+#define STREAMABLE_DEFINE_STATIC_BASE(...)                                                                             \
+    STATIC_ASSERT_HAS_STATIC_STREAMABLE_BASE(__VA_ARGS__)                                                              \
+                                                                                                                       \
+  protected:                                                                                                           \
+    using streamable_bases = std::tuple<__VA_ARGS__>;                                                                  \
+                                                                                                                       \
+    STREAMABLE_RESET_ACCESS_MODIFIER
+
 #define STREAMABLE_DEFINE_FROM_STREAM(className, ...)                                                                  \
   protected:                                                                                                           \
     void FromStream() override                                                                                         \
@@ -150,8 +236,20 @@
 
 #define STREAMABLE_DEFINE_INTRUSIVE                                                                                    \
   private:                                                                                                             \
-    friend class ::hbann::StreamReader;                                                                                \
-    friend class ::hbann::StreamWriter;
+    template <typename, std::endian> friend class ::hbann::BasicStreamReader;                                          \
+    template <typename, std::endian> friend class ::hbann::BasicStreamWriter;                                          \
+    template <typename, typename...> friend class ::hbann::Columnar;                                                   \
+    friend class ::hbann::SizeFinder;
+
+/* Calls the function with all the fields (and attributes) so they can be reached one by one (see Columnar) */
+#define STREAMABLE_DEFINE_APPLY(...)                                                                                   \
+  private:                                                                                                             \
+    template <typename Function> constexpr decltype(auto) StreamableApply(Function &&aFunction)                        \
+    {                                                                                                                  \
+        return aFunction(__VA_ARGS__);                                                                                 \
+    }                                                                                                                  \
+                                                                                                                       \
+    STREAMABLE_RESET_ACCESS_MODIFIER
 
 #define STREAMABLE_STATIC_ASSERTS(className)                                                                           \
   private:                                                                                                             \
@@ -161,16 +259,58 @@
         STATIC_ASSERT_IS_DEFAULT_CONSTRUCTIBLE(className);                                                             \
     }
 
+/* The non virtual Serialize and Deserialize of the static streamables, they are redefined by every derived class */
+#define STREAMABLE_DEFINE_STATIC_SERIALIZE                                                                             \
+  public:                                                                                                              \
+    [[nodiscard]] constexpr ::hbann::Stream Serialize()                                                                \
+    {                                                                                                                  \
+        return ::hbann::StaticStreamable::SerializeStreamable(*this);                                                  \
+    }                                                                                                                  \
+                                                                                                                       \
+    ::hbann::Stream Serialize(const std::filesystem::path &aFile)                                                      \
+    {                                                                                                                  \
+        return ::hbann::StaticStreamable::SerializeStreamable(*this, aFile);                                           \
+    }                                                                                                                  \
+                                                                                                                       \
+    constexpr ::hbann::Size::size_max Serialize(const std::span<uint8_t> aBuffer)                                      \
+    {                                                                                                                  \
+        return ::hbann::StaticStreamable::SerializeStreamable(*this, aBuffer);                                         \
+    }                                                                                                                  \
+                                                                                                                       \
+    constexpr void Deserialize(::hbann::Stream &&aStream)                                                              \
+    {                                                                                                                  \
+        ::hbann::StaticStreamable::DeserializeStreamable(*this, std::move(aStream));                                   \
+    }                                                                                                                  \
+                                                                                                                       \
+    void Deserialize(const std::filesystem::path &aFile, const bool aRemoveFile = false)                               \
+    {                                                                                                                  \
+        ::hbann::StaticStreamable::DeserializeStreamable(*this, aFile, aRemoveFile);                                   \
+    }                                                                                                                  \
+                                                                                                                       \
+    STREAMABLE_RESET_ACCESS_MODIFIER
+
 #define STREAMABLE_DEFINE(className, ...)                                                                              \
     STREAMABLE_STATIC_ASSERTS(className)                                                                               \
                                                                                                                        \
     STREAMABLE_DEFINE_INTRUSIVE                                                                                        \
+    STREAMABLE_DEFINE_APPLY(__VA_ARGS__)                                                                               \
                                                                                                                        \
     STREAMABLE_DEFINE_TO_STREAM(className, __VA_ARGS__)                                                                \
     STREAMABLE_DEFINE_FROM_STREAM(className, __VA_ARGS__)                                                              \
                                                                                                                        \
     STREAMABLE_RESET_ACCESS_MODIFIER
 
+/* Like STREAMABLE_DEFINE for the classes that inherit ::hbann::StaticStreamable */
+#define STREAMABLE_DEFINE_STATIC(className, ...)                                                                       \
+    STREAMABLE_STATIC_ASSERTS(className)                                                                               \
+                                                                                                                       \
+    STREAMABLE_DEFINE_INTRUSIVE                                                                                        \
+    STREAMABLE_DEFINE_APPLY(__VA_ARGS__)                                                                               \
+                                                                                                                       \
+    STREAMABLE_DEFINE_STATIC_SERIALIZE                                                                                 \
+                                                                                                                       \
+    STREAMABLE_RESET_ACCESS_MODIFIER
+
 namespace hbann
 {
 namespace detail
@@ -223,6 +363,22 @@ template <typename> struct is_basic_string : std::false_type
 template <typename... Types> struct is_basic_string<std::basic_string<Types...>> : std::true_type
 {
 };
+
+template <typename> struct is_array : std::false_type
+{
+};
+template <typename Type, size_t vSize> struct is_array<std::array<Type, vSize>> : std::true_type
+{
+};
+
+// the type of the elements of (nested) std::arrays
+template <typename Type> struct array_leaf
+{
+    using type = Type;
+};
+template <typename Type, size_t vSize> struct array_leaf<std::array<Type, vSize>> : array_leaf<Type>
+{
+};
 } // namespace detail
 
 template <typename Type> inline constexpr bool is_pair_v = detail::is_pair<Type>::value;
@@ -232,6 +388,9 @@ template <typename Type> inline constexpr bool is_optional_v = detail::is_option
 template <typename Type> inline constexpr bool is_unique_ptr_v = detail::is_unique_ptr<Type>::value;
 template <typename Type> inline constexpr bool is_shared_ptr_v = detail::is_shared_ptr<Type>::value;
 template <typename Type> inline constexpr bool is_basic_string_v = detail::is_basic_string<Type>::value;
+template <typename Type> inline constexpr bool is_array_v = detail::is_array<Type>::value;
+
+template <typename Type> using array_leaf_t = typename detail::array_leaf<Type>::type;
 
 template <typename> inline constexpr auto always_false = false;
 
@@ -258,15 +417,51 @@ concept is_derived_from_pointer =
 template <typename... Types>
 concept are_derived_from_istreamable = (std::derived_from<Types, IStreamable> && ...);
 
+template <typename Type>
+concept is_attribute = std::derived_from<Type, Attribute>;
+
 template <typename... Types>
 concept are_same_as_istreamable = (std::is_same_v<Types, IStreamable> || ...);
 
 template <typename Type>
-concept is_standard_layout_no_pointer = std::is_standard_layout_v<Type> && !is_any_pointer<Type>;
+concept is_static_streamable = std::derived_from<Type, StaticStreamable>;
+
+template <typename... Types>
+concept are_derived_from_static_streamable = (is_static_streamable<Types> && ...);
+
+// the aggregates that can't be copied as they are in memory are written field by field (see Reflector)
+template <typename Type>
+concept is_reflectable_aggregate = std::is_aggregate_v<Type> && !std::is_trivially_copyable_v<Type> &&
+                                   !std::is_array_v<Type> && !std::is_union_v<Type> && !std::ranges::range<Type> &&
+                                   !is_static_streamable<Type>;
+
+// the static streamables and the reflectable aggregates are written field by field even when they are standard layout
+template <typename Type>
+concept is_standard_layout_no_pointer = std::is_standard_layout_v<Type> && !is_any_pointer<Type> &&
+                                        !is_static_streamable<Type> && !is_reflectable_aggregate<Type>;
 
 template <typename Type>
 concept is_path = std::is_same_v<Type, std::filesystem::path>;
 
+// the objects written in memory as they are by the StreamWriter
+template <typename Type>
+concept is_object_of_known_size = is_standard_layout_no_pointer<Type> && !is_attribute<Type> && !is_optional_v<Type> &&
+                                  !is_variant_v<Type> && !is_tuple_v<Type> && !is_pair_v<Type> &&
+                                  !std::ranges::range<Type> && !std::derived_from<Type, IStreamable>;
+
+// (nested) std::arrays of objects of known size are one contiguous block of memory
+template <typename Type>
+concept is_array_of_known_size =
+    is_array_v<Type> && is_object_of_known_size<array_leaf_t<Type>> && std::is_trivially_copyable_v<Type>;
+
+template <typename Container>
+concept is_range_of_arrays_of_known_size =
+    std::ranges::contiguous_range<Container> && is_array_of_known_size<typename Container::value_type>;
+
+template <typename Type>
+concept is_byte_swappable = (std::is_arithmetic_v<Type> || std::is_enum_v<Type>) &&
+                            (sizeof(Type) == 1 || sizeof(Type) == 2 || sizeof(Type) == 4 || sizeof(Type) == 8);
+
 template <typename Container>
 concept is_range_standard_layout =
     (std::ranges::contiguous_range<Container> && is_standard_layout_no_pointer<typename Container::value_type>) ||
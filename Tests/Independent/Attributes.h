@@ -0,0 +1,332 @@
+#pragma once
+
+struct Telemetry : public hbann::IStreamable
+{
+    STREAMABLE_DEFINE(Telemetry, id, hbann::XorCompressed(samples), hbann::XorCompressed(samplesFloat),
+                      hbann::XorCompressed(last))
+
+  public:
+    int id{};
+    std::vector<double> samples{};
+    std::vector<float> samplesFloat{};
+    std::array<double, 4> last{};
+};
+
+struct Geometry : public hbann::IStreamable
+{
+    STREAMABLE_DEFINE(Geometry, hbann::Float16(radius), hbann::BFloat16(weight), hbann::Float16(vertices),
+                      hbann::BFloat16(normals), hbann::Quantized(angle, 12, -4., 4.),
+                      hbann::Quantized(heights, 10, 0., 100.), hbann::Float16(corners),
+                      hbann::Quantized(bounds, 16, -1., 1.))
+
+  public:
+    double radius{};
+    float weight{};
+    std::vector<float> vertices{};
+    std::vector<double> normals{};
+    double angle{};
+    std::vector<float> heights{};
+    std::array<float, 3> corners{};
+    std::array<double, 2> bounds{};
+};
+
+struct Levels : public hbann::IStreamable
+{
+    STREAMABLE_DEFINE(Levels, hbann::Quantized(levels, 12, 0., 1.))
+
+  public:
+    std::vector<double> levels{};
+};
+
+struct Catalog : public hbann::IStreamable
+{
+    STREAMABLE_DEFINE(Catalog, hbann::Dictionary(tags), hbann::Dictionary(entries), name)
+
+  public:
+    std::vector<std::string> tags{};
+    std::vector<std::map<std::string, std::string>> entries{};
+    std::string name{};
+};
+
+struct Index : public hbann::IStreamable
+{
+    STREAMABLE_DEFINE(Index, hbann::FrontCoded(files), hbann::FrontCoded(urls), hbann::FrontCoded(names))
+
+  public:
+    std::set<std::string> files{};
+    std::map<std::string, std::vector<int>> urls{};
+    std::vector<std::string> names{};
+};
+
+struct Corpus : public hbann::IStreamable
+{
+    STREAMABLE_DEFINE(Corpus, hbann::StringBlob(words), hbann::StringBlob(views))
+
+  public:
+    std::vector<std::string> words{};
+    std::vector<std::string_view> views{};
+};
+
+struct Point
+{
+    int x{};
+    float y{};
+    bool visible{};
+
+    bool operator==(const Point &) const = default;
+};
+
+struct Reading : public hbann::IStreamable
+{
+    STREAMABLE_DEFINE(Reading, id, value, hbann::Float16(level), name)
+
+  public:
+    uint32_t id{};
+    double value{};
+    float level{};
+    std::string name{};
+
+    bool operator==(const Reading &aReading) const
+    {
+        return id == aReading.id && value == aReading.value && level == aReading.level && name == aReading.name;
+    }
+};
+
+struct Scene : public hbann::IStreamable
+{
+    STREAMABLE_DEFINE(Scene, hbann::Columnar(readings), hbann::Columnar(circles),
+                      hbann::Columnar(points, &Point::x, &Point::y, &Point::visible))
+
+  public:
+    std::vector<Reading> readings{};
+    std::vector<Circle> circles{};
+    std::vector<Point> points{};
+};
+
+struct Path : public hbann::IStreamable
+{
+    STREAMABLE_DEFINE(Path, hbann::Columnar(points, &Point::x, &Point::y, &Point::visible))
+
+  public:
+    std::vector<Point> points{};
+};
+
+TEST_CASE("Streamable::Independent::Attributes", "[Streamable][Independent][Attributes]")
+{
+    SECTION("XorCompressed")
+    {
+        Telemetry telemetryStart;
+        telemetryStart.id = 42;
+        for (size_t i = 0; i < 1000; i++)
+        {
+            telemetryStart.samples.push_back(20. + static_cast<double>(i / 10) * 0.25);
+            telemetryStart.samplesFloat.push_back(static_cast<float>(i % 7) - 3.5f);
+        }
+        telemetryStart.last = {20.25, 20.25, 20.5, 21.};
+
+        auto stream = telemetryStart.Serialize();
+        const auto sizeRaw = telemetryStart.samples.size() * sizeof(double) +
+                             telemetryStart.samplesFloat.size() * sizeof(float);
+        REQUIRE(stream.View().size() < sizeRaw / 4);
+
+        Telemetry telemetryEnd;
+        telemetryEnd.Deserialize(std::move(stream));
+
+        REQUIRE(telemetryStart.id == telemetryEnd.id);
+        REQUIRE(telemetryStart.samples == telemetryEnd.samples);
+        REQUIRE(telemetryStart.samplesFloat == telemetryEnd.samplesFloat);
+        REQUIRE(telemetryStart.last == telemetryEnd.last);
+    }
+    SECTION("HalfFloat/Quantized")
+    {
+        Geometry geometryStart;
+        geometryStart.radius = 1.5;
+        geometryStart.weight = 72.5f;
+        geometryStart.angle = 3.14159;
+        geometryStart.corners = {1.5f, -2.f, 0.25f};
+        geometryStart.bounds = {0.5, -0.25};
+        for (size_t i = 0; i < 100; i++)
+        {
+            geometryStart.vertices.push_back(static_cast<float>(i) * 0.5f - 20.f);
+            geometryStart.normals.push_back(static_cast<double>(i % 3) - 1.);
+            geometryStart.heights.push_back(static_cast<float>(i));
+        }
+
+        Geometry geometryEnd;
+        geometryEnd.Deserialize(geometryStart.Serialize());
+
+        REQUIRE(geometryStart.radius == geometryEnd.radius);
+        REQUIRE(geometryStart.weight == geometryEnd.weight);
+        REQUIRE(geometryStart.vertices == geometryEnd.vertices);
+        REQUIRE(geometryStart.normals == geometryEnd.normals);
+        REQUIRE(std::abs(geometryStart.angle - geometryEnd.angle) <= 8. / 4095);
+
+        REQUIRE(geometryStart.heights.size() == geometryEnd.heights.size());
+        for (size_t i = 0; i < geometryStart.heights.size(); i++)
+        {
+            REQUIRE(std::abs(geometryStart.heights[i] - geometryEnd.heights[i]) <= 100. / 1023);
+        }
+
+        REQUIRE(geometryStart.corners == geometryEnd.corners);
+        for (size_t i = 0; i < geometryStart.bounds.size(); i++)
+        {
+            REQUIRE(std::abs(geometryStart.bounds[i] - geometryEnd.bounds[i]) <= 2. / 65535);
+        }
+
+        // a corrupted count doesn't allocate more values than the bytes have
+        Levels levelsStart;
+        levelsStart.levels.assign(100, 0.5);
+        auto stream = levelsStart.Serialize();
+        const auto bytes = stream.View();
+
+        const auto count = hbann::Size::MakeSize(0x7FFFFFFF);
+        std::vector<uint8_t> bytesCorrupted(count.data.begin(), count.data.begin() + count.count);
+        bytesCorrupted.insert(bytesCorrupted.end(), bytes.begin() + hbann::Size::FindRequiredBytes(bytes[0]),
+                              bytes.end());
+
+        Levels levelsEnd;
+        levelsEnd.Deserialize(hbann::Stream(std::span<const uint8_t>(bytesCorrupted)));
+        REQUIRE(levelsEnd.levels.size() == levelsStart.levels.size());
+    }
+    SECTION("Dictionary")
+    {
+        const std::vector<std::string> words{"cariceps", "biceps", "", "a string that doesn't fit the SSO buffer"};
+
+        Catalog catalogStart;
+        catalogStart.name = "cariceps";
+        for (size_t i = 0; i < 1000; i++)
+        {
+            catalogStart.tags.push_back(words[i % words.size()]);
+            catalogStart.entries.push_back({{"name", words[i % 3]}, {"type", words[(i + 1) % words.size()]}});
+        }
+
+        auto stream = catalogStart.Serialize();
+        REQUIRE(stream.View().size() < catalogStart.tags.size() * 8);
+
+        Catalog catalogEnd;
+        catalogEnd.Deserialize(std::move(stream));
+
+        REQUIRE(catalogStart.tags == catalogEnd.tags);
+        REQUIRE(catalogStart.entries == catalogEnd.entries);
+        REQUIRE(catalogStart.name == catalogEnd.name);
+
+        // the reference to a string that was not read before is corrupted
+        Catalog catalogCorrupted;
+        catalogCorrupted.tags = {"ab", "ab"};
+
+        auto bytes = catalogCorrupted.Serialize().Release();
+        const auto reference = std::ranges::search(bytes, std::string_view("ab")).end();
+        REQUIRE(*reference == hbann::Size::MakeSize(1).data[0]);
+        *reference = hbann::Size::MakeSize(2).data[0];
+
+        REQUIRE_THROWS_AS(catalogEnd.Deserialize(hbann::Stream(std::span<const uint8_t>(bytes))), std::out_of_range);
+    }
+    SECTION("FrontCoded")
+    {
+        Index indexStart;
+        for (int i = 0; i < 500; i++)
+        {
+            const auto number = std::to_string(i);
+            indexStart.files.insert("C:/Users/cariceps/Documents/Projects/Streamable/Tests/" + number + ".h");
+            indexStart.urls.emplace("https://github.com/ClaudiuHBann/Streamable/issues/" + number, std::vector{i, -i});
+            indexStart.names.push_back(i % 2 ? number : "");
+        }
+
+        size_t sizeKeys{};
+        for (const auto &file : indexStart.files)
+        {
+            sizeKeys += file.size();
+        }
+        for (const auto &[url, _] : indexStart.urls)
+        {
+            sizeKeys += url.size();
+        }
+
+        auto stream = indexStart.Serialize();
+        REQUIRE(stream.View().size() < sizeKeys / 2);
+
+        Index indexEnd;
+        indexEnd.Deserialize(std::move(stream));
+
+        REQUIRE(indexStart.files == indexEnd.files);
+        REQUIRE(indexStart.urls == indexEnd.urls);
+        REQUIRE(indexStart.names == indexEnd.names);
+
+        // a shared prefix longer than the previous key is corrupted (the first one has nothing before it)
+        const auto view = indexStart.Serialize().View();
+        std::vector<uint8_t> bytes(view.begin(), view.end());
+        const auto countSize = hbann::Size::FindRequiredBytes(bytes[0]);
+        REQUIRE(bytes[countSize] == hbann::Size::MakeSize(0).data[0]);
+        bytes[countSize] = hbann::Size::MakeSize(1).data[0];
+        REQUIRE_THROWS_AS(indexEnd.Deserialize(hbann::Stream(std::span<const uint8_t>(bytes))), std::length_error);
+    }
+    SECTION("StringBlob")
+    {
+        Corpus corpusStart;
+        for (size_t i = 0; i < 1000; i++)
+        {
+            corpusStart.words.push_back(std::string(i % 20, char('a' + i % 26)));
+        }
+        corpusStart.views.assign(corpusStart.words.begin(), corpusStart.words.end());
+
+        // the views point into the stream so we keep it
+        Corpus corpusEnd;
+        corpusEnd.Deserialize(corpusStart.Serialize(), false);
+
+        REQUIRE(corpusStart.words == corpusEnd.words);
+        REQUIRE(corpusStart.views == corpusEnd.views);
+
+        // the strings of corrupted offsets after the blob are not read
+        hbann::Stream stream;
+        hbann::StreamWriter(stream).WriteAll(std::vector<uint32_t>{2, 100, 5}, std::string("abcde"));
+
+        std::vector<std::string> words{};
+        hbann::StreamReader streamReader(stream);
+        hbann::StringBlob(words).FromStream(streamReader);
+        REQUIRE(words == std::vector<std::string>{"ab"});
+    }
+    SECTION("Columnar")
+    {
+        Scene sceneStart;
+        for (uint32_t i = 0; i < 100; i++)
+        {
+            sceneStart.readings.push_back({});
+            sceneStart.readings.back().id = i;
+            sceneStart.readings.back().value = i * 0.5;
+            sceneStart.readings.back().level = static_cast<float>(i % 8);
+            sceneStart.readings.back().name = std::to_string(i);
+
+            sceneStart.points.push_back({static_cast<int>(i), i * 0.25f, i % 2 == 0});
+        }
+        sceneStart.circles.emplace_back(GUID_RND, "cariceps", "C:/cariceps.svg", std::vector{1., 2.});
+        sceneStart.circles.emplace_back(guid{}, std::nullopt, "", true);
+
+        Scene sceneEnd;
+        sceneEnd.Deserialize(sceneStart.Serialize());
+
+        REQUIRE(sceneStart.readings == sceneEnd.readings);
+        REQUIRE(sceneStart.circles == sceneEnd.circles);
+        REQUIRE(sceneStart.points == sceneEnd.points);
+
+        // a column that doesn't have a value for each element is corrupted
+        Path pathStart, pathEnd;
+        pathStart.points = sceneStart.points;
+        const auto view = pathStart.Serialize().View();
+        const std::vector<uint8_t> bytes(view.begin(), view.end());
+        const auto countSize = hbann::Size::FindRequiredBytes(bytes[0]);
+
+        auto bytesCorrupted = bytes;
+        const auto countColumn = hbann::Size::MakeSize(pathStart.points.size() / 2);
+        REQUIRE(countColumn.count == hbann::Size::FindRequiredBytes(bytes[countSize]));
+        std::copy_n(countColumn.data.begin(), countColumn.count, bytesCorrupted.begin() + countSize);
+        REQUIRE_THROWS_AS(pathEnd.Deserialize(hbann::Stream(std::span<const uint8_t>(bytesCorrupted))),
+                          std::length_error);
+
+        // a corrupted count doesn't allocate more elements than the bytes left
+        const auto count = hbann::Size::MakeSize(0x7FFFFFFF);
+        bytesCorrupted.assign(count.data.begin(), count.data.begin() + count.count);
+        bytesCorrupted.insert(bytesCorrupted.end(), bytes.begin() + countSize, bytes.end());
+        REQUIRE_THROWS_AS(pathEnd.Deserialize(hbann::Stream(std::span<const uint8_t>(bytesCorrupted))),
+                          std::length_error);
+    }
+}
@@ -1,5 +1,55 @@
 #pragma once
 
+struct Address
+{
+    std::string street{};
+    uint16_t number{};
+
+    bool operator==(const Address &) const = default;
+};
+
+struct Person
+{
+    uint32_t id{};
+    double height{};
+    std::string name{};
+    std::vector<std::string> emails{};
+    std::optional<Address> home{};
+    std::map<std::string, int32_t> scores{};
+    std::vector<Address> addresses{};
+    std::variant<int32_t, std::string> tag{};
+
+    bool operator==(const Person &) const = default;
+};
+
+// more fields than STREAMABLE_DEFINE supports
+struct Settings
+{
+    int32_t f1{}, f2{}, f3{}, f4{}, f5{}, f6{}, f7{}, f8{}, f9{}, f10{}, f11{}, f12{}, f13{}, f14{}, f15{};
+    std::string s1{}, s2{}, s3{}, s4{}, s5{}, s6{}, s7{}, s8{}, s9{}, s10{}, s11{}, s12{}, s13{}, s14{}, s15{};
+
+    bool operator==(const Settings &) const = default;
+};
+
+// a serialization that throws after it wrote some bytes
+struct Failing : public hbann::IStreamable
+{
+  public:
+    std::string bytes = std::string(1000, 'x');
+
+  protected:
+    void ToStream() override
+    {
+        mStreamWriter.WriteAll(bytes);
+        throw std::runtime_error("Failing!");
+    }
+
+    void FromStream() override
+    {
+        mStreamReader.ReadAll(bytes);
+    }
+};
+
 TEST_CASE("Streamable::Independent::Streams", "[Streamable][Independent][Streams]")
 {
     SECTION("Stream")
@@ -59,4 +109,974 @@ TEST_CASE("Streamable::Independent::Streams", "[Streamable][Independent][Streams
         REQUIRE(d == dd);
         REQUIRE(s == ss);
     }
+    SECTION("StreamReader/StreamWriter Size Policies")
+    {
+        ForEachSizeType([]<typename SizeType>(const SizeType &) {
+            hbann::Stream stream;
+            hbann::BasicStreamWriter<SizeType> streamWriter(stream);
+            hbann::BasicStreamReader<SizeType> streamReader(stream);
+
+            std::string s(300, 'x');
+            std::vector<std::string> vs{"cariceps", "", "biceps"};
+            std::optional<int> o(42);
+            streamWriter.WriteAll(s, vs, o);
+
+            std::string ss{};
+            std::vector<std::string> vss{};
+            std::optional<int> oo{};
+            streamReader.ReadAll(ss, vss, oo);
+
+            REQUIRE(s == ss);
+            REQUIRE(vs == vss);
+            REQUIRE(o == oo);
+        });
+    }
+    SECTION("StreamReader/StreamWriter Endianness")
+    {
+        constexpr auto endian = std::endian::native == std::endian::little ? std::endian::big : std::endian::little;
+
+        hbann::Stream stream;
+        hbann::BasicStreamWriter<hbann::Size, endian> streamWriter(stream);
+        hbann::BasicStreamReader<hbann::Size, endian> streamReader(stream);
+
+        uint32_t u = 0x01020304;
+        std::vector<uint16_t> vu(100);
+        std::iota(vu.begin(), vu.end(), uint16_t(0x0100));
+        std::vector<double> vd{1.5, -2.25, 1e300};
+        std::u16string us(u"cariceps");
+        streamWriter.WriteAll(u, vu, vd, us);
+
+        const auto view = stream.View();
+        REQUIRE(uint8_t(view[0]) == (endian == std::endian::big ? 0x01 : 0x04));
+        REQUIRE(uint8_t(view[3]) == (endian == std::endian::big ? 0x04 : 0x01));
+
+        uint32_t uu{};
+        std::vector<uint16_t> vuu{};
+        std::vector<double> vdd{};
+        std::u16string uss{};
+        streamReader.ReadAll(uu, vuu, vdd, uss);
+
+        REQUIRE(u == uu);
+        REQUIRE(vu == vuu);
+        REQUIRE(vd == vdd);
+        REQUIRE(us == uss);
+    }
+    SECTION("StreamReader/StreamWriter Arrays")
+    {
+        ForEachEndian([]<std::endian vEndian>(std::integral_constant<std::endian, vEndian>) {
+            hbann::Stream stream;
+            hbann::BasicStreamWriter<hbann::Size, vEndian> streamWriter(stream);
+            hbann::BasicStreamReader<hbann::Size, vEndian> streamReader(stream);
+
+            std::vector<std::array<float, 3>> vertices(100);
+            for (size_t i = 0; i < vertices.size(); i++)
+            {
+                vertices[i] = {i * 1.f, i * 2.f, i * 3.f};
+            }
+            std::array<std::array<double, 4>, 4> matrix{
+                {{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}, {13, 14, 15, 16}}};
+            std::array<std::string, 3> names{"cariceps", "", "biceps"};
+            streamWriter.WriteAll(vertices, matrix, names);
+
+            // one count and one block for the contiguous ranges of arrays
+            const auto sizeNames = 1 + 1 + 8 + 1 + 1 + 6;
+            REQUIRE(stream.View().size() == 2 + vertices.size() * sizeof(vertices[0]) + 1 + sizeof(matrix) + sizeNames);
+
+            std::vector<std::array<float, 3>> verticesRead{};
+            std::array<std::array<double, 4>, 4> matrixRead{};
+            std::array<std::string, 3> namesRead{};
+            streamReader.ReadAll(verticesRead, matrixRead, namesRead);
+
+            REQUIRE(vertices == verticesRead);
+            REQUIRE(matrix == matrixRead);
+            REQUIRE(names == namesRead);
+        });
+    }
+    SECTION("StreamReader/StreamWriter Objects Of Known Size")
+    {
+        ForEachEndian([]<std::endian vEndian>(std::integral_constant<std::endian, vEndian>) {
+            hbann::Stream stream;
+            hbann::BasicStreamWriter<hbann::Size, vEndian> streamWriter(stream);
+            hbann::BasicStreamReader<hbann::Size, vEndian> streamReader(stream);
+
+            enum class Side : uint16_t
+            {
+                BUY = 0x0102,
+                SELL
+            };
+
+            int i = -42;
+            double d = 12.34;
+            char c = 'c';
+            Side side = Side::BUY;
+            std::string s("cariceps");
+            bool b = true;
+            uint64_t u = 0x0102030405060708;
+            streamWriter.WriteAll(i, d, c, side, s, b, u);
+
+            REQUIRE(stream.View().size() == sizeof(i) + sizeof(d) + sizeof(c) + sizeof(side) + 1 + s.size() +
+                                                sizeof(b) + sizeof(u));
+
+            int ii{};
+            double dd{};
+            char cc{};
+            Side sside{};
+            std::string ss{};
+            bool bb{};
+            uint64_t uu{};
+            streamReader.ReadAll(ii, dd, cc, sside, ss, bb, uu);
+
+            REQUIRE(i == ii);
+            REQUIRE(d == dd);
+            REQUIRE(c == cc);
+            REQUIRE(side == sside);
+            REQUIRE(s == ss);
+            REQUIRE(b == bb);
+            REQUIRE(u == uu);
+        });
+
+
+        // the objects that don't fit in the buffer on the stack are written on their own and a gather references them
+        struct Matrix
+        {
+            double values[512][1024];
+        };
+
+        const auto matrix = std::make_unique<Matrix>(), matrixOther = std::make_unique<Matrix>();
+        matrix->values[1][2] = 3.;
+        matrixOther->values[511][1023] = 4.;
+        uint8_t header = 7;
+
+        const auto bytes = hbann::Serialize(header, *matrix, *matrixOther);
+        REQUIRE(bytes.size() == sizeof(header) + 2 * sizeof(Matrix));
+
+        const auto matrixRead = std::make_unique<Matrix>(), matrixOtherRead = std::make_unique<Matrix>();
+        uint8_t headerRead{};
+        hbann::DeserializeInto(bytes, headerRead, *matrixRead, *matrixOtherRead);
+        REQUIRE(headerRead == header);
+        REQUIRE(!std::memcmp(matrixRead.get(), matrix.get(), sizeof(Matrix)));
+        REQUIRE(!std::memcmp(matrixOtherRead.get(), matrixOther.get(), sizeof(Matrix)));
+
+        hbann::Stream stream(hbann::StreamGather{});
+        hbann::StreamWriter(stream).WriteAll(header, *matrix, *matrixOther);
+        const auto &spans = stream.Gather();
+        const auto matrixBytes = reinterpret_cast<const uint8_t *>(matrix.get());
+        REQUIRE(std::ranges::any_of(spans, [&](const auto aSpan) { return aSpan.data() == matrixBytes; }));
+        REQUIRE(stream.Release() == bytes);
+    }
+    SECTION("ConstantWriter")
+    {
+        struct Entry
+        {
+            uint32_t key{};
+            float value{};
+
+            constexpr bool operator==(const Entry &) const noexcept = default;
+        };
+
+        static constexpr auto makeTable = [] {
+            return std::tuple{std::array<Entry, 3>{{{1, 1.5f}, {2, -2.25f}, {0x01020304, 1e30f}}},
+                              std::string_view("cariceps"), std::optional<int>(42), std::variant<int, float>(1.5f),
+                              std::vector<std::array<float, 2>>{{1.f, 2.f}, {3.f, 4.f}}};
+        };
+
+        ForEachEndian([]<std::endian vEndian>(std::integral_constant<std::endian, vEndian>) {
+            constexpr auto bytes = hbann::BasicConstantWriter<hbann::Size, vEndian>::Serialize(makeTable);
+
+            hbann::Stream stream;
+            hbann::BasicStreamWriter<hbann::Size, vEndian> streamWriter(stream);
+
+            auto table = makeTable();
+            std::apply([&](auto &...aObjects) { streamWriter.WriteAll(aObjects...); }, table);
+
+            const auto view = stream.View();
+            REQUIRE(std::equal(bytes.begin(), bytes.end(), view.begin(), view.end()));
+
+            hbann::Stream streamConstant(std::span<const uint8_t>(bytes.data(), bytes.size()));
+            hbann::BasicStreamReader<hbann::Size, vEndian> streamReader(streamConstant);
+
+            decltype(table) tableRead{};
+            auto &[entries, string, optional, variant, vectors] = tableRead;
+            std::string stringRead{};
+            streamReader.ReadAll(entries, stringRead, optional, variant, vectors);
+
+            REQUIRE(std::get<0>(table) == entries);
+            REQUIRE(std::get<1>(table) == stringRead);
+            REQUIRE(std::get<2>(table) == optional);
+            REQUIRE(std::get<3>(table) == variant);
+            REQUIRE(std::get<4>(table) == vectors);
+        });
+    }
+    SECTION("StreamReader/StreamWriter Aggregates")
+    {
+        static_assert(hbann::Reflector::FindFieldCount<Person>() == 8);
+        static_assert(hbann::Reflector::FindFieldCount<Settings>() == 30);
+
+        hbann::Stream stream;
+        hbann::StreamWriter streamWriter(stream);
+        hbann::StreamReader streamReader(stream);
+
+        Person person{7, 1.83, "HBann", {"a@b.c", "d@e.f"}, Address{"Main", 42}, {{"math", 10}, {"art", 9}},
+                      {{"Second", 1}, {"Third", 2}}, std::string("tag")};
+        std::vector<Person> persons{person, Person{.id = 8, .name = "Claudiu"}};
+
+        Settings settings{};
+        settings.f15 = 15;
+        settings.s1 = "first";
+        settings.s15 = "last";
+
+        streamWriter.WriteAll(person, persons, settings);
+
+        // the leading fields of known size are written as they are and the rest field by field
+        REQUIRE(stream.View().size() > sizeof(person.id) + sizeof(person.height) + 1 + person.name.size());
+
+        Person personRead{};
+        std::vector<Person> personsRead{};
+        Settings settingsRead{};
+        streamReader.ReadAll(personRead, personsRead, settingsRead);
+
+        REQUIRE(person == personRead);
+        REQUIRE(persons == personsRead);
+        REQUIRE(settings == settingsRead);
+
+        REQUIRE(!hbann::is_serialized_size_bounded<Person>);
+    }
+
+    SECTION("Serialize/Deserialize")
+    {
+        const std::map<int32_t, std::vector<double>> cache{{1, {1.5, 2.5}}, {2, {}}, {3, {-3.25}}};
+
+        const auto bytes = hbann::Serialize(cache);
+        REQUIRE(hbann::Deserialize<std::map<int32_t, std::vector<double>>>(bytes) == cache);
+
+        hbann::Stream stream;
+        hbann::StreamWriter(stream).WriteAll(const_cast<std::map<int32_t, std::vector<double>> &>(cache));
+        REQUIRE(std::ranges::equal(bytes, stream.View()));
+
+        const Person person{.id = 7, .name = "HBann", .emails = {"a@b.c"}};
+        const auto bytesBig = hbann::Serialize<hbann::SizeFixed, std::endian::big>(person, 42, std::string("args"));
+
+        Person personRead{};
+        int32_t i{};
+        std::string s{};
+        hbann::DeserializeInto<hbann::SizeFixed, std::endian::big>(bytesBig, personRead, i, s);
+        REQUIRE(person == personRead);
+        REQUIRE(i == 42);
+        REQUIRE(s == "args");
+
+        const std::optional<int16_t> optional(-7);
+        std::array<uint8_t, hbann::max_serialized_size<std::tuple<double, std::optional<int16_t>>> + 1> buffer{};
+        const auto size = hbann::SerializeInto(buffer, 12.34, optional);
+        REQUIRE(size == hbann::max_serialized_size<std::tuple<double, std::optional<int16_t>>>);
+
+        double d{};
+        std::optional<int16_t> optionalRead{};
+        hbann::DeserializeInto(std::span(buffer.data(), *size), d, optionalRead);
+        REQUIRE(d == 12.34);
+        REQUIRE(optional == optionalRead);
+
+        // the objects that don't fit are not written after the end of the buffer
+        std::array<uint8_t, 16> bufferSmall{};
+        REQUIRE(!hbann::SerializeInto(std::span(bufferSmall).first(8), std::string(64, 'x')));
+        REQUIRE(std::ranges::all_of(std::span(bufferSmall).subspan(8), [](const auto aByte) { return !aByte; }));
+    }
+
+    SECTION("StreamFile")
+    {
+        const auto path = std::filesystem::temp_directory_path() / "Streamable.StreamFile.bin";
+
+        // bigger than the buffers so the writes and the reads go through both of them many times
+        std::vector<uint32_t> numbers(hbann::StreamFile::BUFFER_SIZE);
+        std::iota(numbers.begin(), numbers.end(), 0u);
+        std::vector<std::string> strings(1000, std::string(333, 'x'));
+        const Person person{.id = 7, .name = "HBann", .emails = {"a@b.c"}};
+
+        {
+            hbann::Stream stream(path, hbann::StreamUsageType::SERIALIZE);
+            hbann::StreamWriter(stream).WriteAll(numbers, strings, const_cast<Person &>(person));
+            stream.Clear();
+            REQUIRE(!stream.HasFailed());
+        }
+
+        REQUIRE(std::filesystem::file_size(path) > 2 * hbann::StreamFile::BUFFER_SIZE);
+
+#ifdef __linux__
+        // the writes fail because the device is always full
+        {
+            hbann::Stream stream("/dev/full", hbann::StreamUsageType::SERIALIZE);
+            hbann::StreamWriter(stream).WriteAll(numbers);
+            REQUIRE(!stream.Sync());
+            REQUIRE(stream.HasFailed());
+        }
+#endif // __linux__
+
+        std::vector<uint32_t> numbersRead{};
+        std::vector<std::string> stringsRead{};
+        Person personRead{};
+
+        hbann::Stream stream(path, hbann::StreamUsageType::DESERIALIZE);
+        hbann::StreamReader(stream).ReadAll(numbersRead, stringsRead, personRead);
+        REQUIRE(stream.IsEOS());
+        stream.Clear(true);
+
+        REQUIRE(numbers == numbersRead);
+        REQUIRE(strings == stringsRead);
+        REQUIRE(person == personRead);
+        REQUIRE(!std::filesystem::exists(path));
+    }
+
+    SECTION("StreamFile Big Ranges")
+    {
+        const auto path = std::filesystem::temp_directory_path() / "Streamable.StreamFile.Big.bin";
+
+        // the big ranges are read straight into their memory from any offset of the buffers
+        std::string string(3 * hbann::StreamFile::BUFFER_SIZE + 7, 'x');
+        std::ranges::generate(string, [i = 0]() mutable { return static_cast<char>('a' + i++ % 26); });
+        std::vector<uint64_t> numbers(hbann::StreamFile::BUFFER_SIZE / 2);
+        std::iota(numbers.begin(), numbers.end(), 0ull);
+        auto array = std::make_unique<std::array<uint16_t, hbann::StreamFile::BUFFER_SIZE>>();
+        std::iota(array->begin(), array->end(), uint16_t(0));
+
+        {
+            hbann::Stream stream(path, hbann::StreamUsageType::SERIALIZE);
+            hbann::BasicStreamWriter<hbann::Size, std::endian::big> streamWriter(stream);
+            streamWriter.WriteAll(uint8_t(1), string, numbers, *array, uint8_t(2));
+        }
+
+        uint8_t first{}, last{};
+        std::string stringRead{};
+        std::vector<uint64_t> numbersRead{};
+        auto arrayRead = std::make_unique<std::array<uint16_t, hbann::StreamFile::BUFFER_SIZE>>();
+
+        hbann::Stream stream(path, hbann::StreamUsageType::DESERIALIZE);
+        hbann::BasicStreamReader<hbann::Size, std::endian::big>(stream).ReadAll(first, stringRead, numbersRead,
+                                                                                *arrayRead, last);
+        stream.Clear(true);
+
+        REQUIRE(first == 1);
+        REQUIRE(string == stringRead);
+        REQUIRE(numbers == numbersRead);
+        REQUIRE(*array == *arrayRead);
+        REQUIRE(last == 2);
+
+        // a corrupted count doesn't allocate more than the bytes left in the file
+        {
+            hbann::Stream streamCorrupted(path, hbann::StreamUsageType::SERIALIZE);
+            hbann::BasicStreamWriter<hbann::SizeFixed, std::endian::little> streamWriter(streamCorrupted);
+            streamWriter.WriteAll(uint32_t(0x7FFFFFFF), numbers);
+        }
+
+        std::vector<uint64_t> numbersCorrupted{};
+        hbann::Stream streamCorrupted(path, hbann::StreamUsageType::DESERIALIZE);
+        hbann::BasicStreamReader<hbann::SizeFixed, std::endian::little>(streamCorrupted).ReadAll(numbersCorrupted);
+        streamCorrupted.Clear();
+
+        REQUIRE(streamCorrupted.IsEOS());
+        REQUIRE(numbersCorrupted.size() == numbers.size());
+
+#ifndef _WIN32
+        // the descriptors don't know the bytes left so the range grows while it is read
+        numbersCorrupted.clear();
+        hbann::Stream streamDescriptor(open(path.c_str(), O_RDONLY), hbann::StreamUsageType::DESERIALIZE, true);
+        hbann::BasicStreamReader<hbann::SizeFixed, std::endian::little>(streamDescriptor).ReadAll(numbersCorrupted);
+
+        REQUIRE(numbersCorrupted.size() == numbers.size());
+        REQUIRE(numbersCorrupted.capacity() < 4 * numbers.size());
+#endif // !_WIN32
+
+        std::filesystem::remove(path);
+    }
+
+    SECTION("RecordWriter/RecordReader")
+    {
+        const auto path = std::filesystem::temp_directory_path() / "Streamable.Records.bin";
+
+        {
+            hbann::RecordWriter recordWriter(path, false);
+            for (uint32_t i = 0; i < 1000; i++)
+            {
+                recordWriter.Append(Person{.id = i, .name = std::to_string(i), .emails = {}});
+            }
+        }
+
+        // the records are appended after the ones already in the file
+        hbann::RecordWriter recordWriter(path);
+        recordWriter.Append(Person{.id = 1000, .name = "HBann", .emails = {"a@b.c"}});
+        recordWriter.Close();
+
+        hbann::RecordReader recordReader(path);
+        uint32_t id{};
+        for (const auto &person : recordReader.Records<Person>())
+        {
+            REQUIRE(person.id == id++);
+        }
+        REQUIRE(id == 1001);
+
+        // a record that was not fully appended is not read
+        hbann::RecordWriter(path).Append(uint64_t(42), 1.5f);
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+        hbann::RecordReader recordReaderTorn(path);
+        for (uint32_t i = 0; i < 1000; i++)
+        {
+            REQUIRE(recordReaderTorn.Skip());
+        }
+
+        Person person{};
+        REQUIRE(recordReaderTorn.Next(person));
+        REQUIRE(person.name == "HBann");
+
+        uint64_t u{};
+        float f{};
+        REQUIRE(!recordReaderTorn.Next(u, f));
+
+        // the torn record is cut off so the records appended after it are read
+        {
+            hbann::RecordWriter recordWriterTorn(path);
+            recordWriterTorn.Append(uint64_t(43), 2.5f);
+        }
+
+        hbann::RecordReader recordReaderAppended(path);
+        for (uint32_t i = 0; i < 1001; i++)
+        {
+            REQUIRE(recordReaderAppended.Skip());
+        }
+
+        REQUIRE(recordReaderAppended.Next(u, f));
+        REQUIRE((u == 43 && f == 2.5f));
+        REQUIRE(!recordReaderAppended.Skip());
+        REQUIRE(recordReaderAppended.GetSize() == std::filesystem::file_size(path));
+
+        std::filesystem::remove(path);
+    }
+
+    SECTION("RecordWriter Commit")
+    {
+        const auto path = std::filesystem::temp_directory_path() / "Streamable.Records.Commit.bin";
+
+        // the threads commit while the others append and sync so their records are synced together
+        hbann::RecordWriter recordWriter(path, false);
+        std::vector<std::thread> threads{};
+        std::atomic<uint32_t> failed{};
+        for (uint32_t thread = 0; thread < 4; thread++)
+        {
+            threads.emplace_back([&, thread] {
+                for (uint32_t i = 0; i < 250; i++)
+                {
+                    recordWriter.Append(thread, i);
+                    if (i % 10 == 9 && !recordWriter.Commit())
+                    {
+                        failed++;
+                    }
+                }
+            });
+        }
+
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        REQUIRE(!failed);
+        REQUIRE(recordWriter.Commit());
+        recordWriter.Close();
+
+        std::array<uint32_t, 4> counts{};
+        hbann::RecordReader recordReader(path);
+        uint32_t thread{}, i{};
+        while (recordReader.Next(thread, i))
+        {
+            REQUIRE(i == counts[thread]++);
+        }
+        REQUIRE(counts == std::array<uint32_t, 4>{250, 250, 250, 250});
+
+        std::filesystem::remove(path);
+    }
+
+    SECTION("StreamFile Durable")
+    {
+        const auto path = std::filesystem::temp_directory_path() / "Streamable.Durable.bin";
+        const auto pathOther = std::filesystem::path(path) += ".tmp";
+        const Person person{.id = 7, .name = "HBann", .emails = {"a@b.c"}};
+        std::filesystem::remove(path);
+
+        // the temporary files are new ones next to the file (ex.: Streamable.Durable.bin.0.tmp)
+        const auto countTemporary = [&]() {
+            const auto prefix = path.filename().string() + ".";
+            const auto isTemporary = [&](const auto &aEntry) {
+                const auto name = aEntry.path().filename().string();
+                return name.starts_with(prefix) && name.ends_with(".tmp") && name != pathOther.filename().string();
+            };
+
+            return std::ranges::count_if(std::filesystem::directory_iterator(path.parent_path()), isTemporary);
+        };
+
+        // a file that has the name of a temporary file is not truncated by the durable serializations
+        {
+            std::ofstream other(pathOther, std::ios::binary);
+            other << "other";
+        }
+        const auto countTemporaryBefore = countTemporary();
+
+        // the file appears only when it was serialized entirely and the serializations of the same file at once don't
+        // write the same temporary file
+        {
+            hbann::Stream stream(path, hbann::StreamUsageType::SERIALIZE, false, true);
+            hbann::Stream streamOther(path, hbann::StreamUsageType::SERIALIZE, false, true);
+            hbann::StreamWriter(stream).WriteAll(const_cast<Person &>(person));
+            hbann::StreamWriter(streamOther).WriteAll(std::string("other"));
+            stream.Flush();
+            streamOther.Clear(true);
+
+            REQUIRE(!std::filesystem::exists(path));
+            REQUIRE(countTemporary() == countTemporaryBefore + 1);
+            stream.Clear();
+        }
+
+        REQUIRE(countTemporary() == countTemporaryBefore);
+        REQUIRE(std::filesystem::file_size(pathOther) == 5);
+        std::filesystem::remove(pathOther);
+
+        Person personRead{};
+        {
+            hbann::Stream stream(path, hbann::StreamUsageType::DESERIALIZE);
+            hbann::StreamReader(stream).ReadAll(personRead);
+        }
+        REQUIRE(person == personRead);
+
+        // the old file is kept when the new one is removed before replacing it
+        {
+            hbann::Stream stream(path, hbann::StreamUsageType::SERIALIZE, false, true);
+            hbann::StreamWriter(stream).WriteAll(std::string("partial"));
+            stream.Clear(true);
+        }
+
+#if defined(__linux__) || defined(__APPLE__)
+        // the old file is kept when a write of the new one failed (it is bigger than the files can be)
+        {
+            rlimit limit{};
+            getrlimit(RLIMIT_FSIZE, &limit);
+            const auto limitOld = limit;
+            const auto signalOld = signal(SIGXFSZ, SIG_IGN);
+
+            limit.rlim_cur = 600 * 1024;
+            setrlimit(RLIMIT_FSIZE, &limit);
+            {
+                hbann::Stream stream(path, hbann::StreamUsageType::SERIALIZE, false, true);
+                hbann::StreamWriter(stream).WriteAll(std::string(2 * 1024 * 1024, 'x'));
+                stream.Clear();
+
+                REQUIRE(stream.HasFailed());
+            }
+            setrlimit(RLIMIT_FSIZE, &limitOld);
+            signal(SIGXFSZ, signalOld);
+        }
+#endif // defined(__linux__) || defined(__APPLE__)
+
+        // the old file is kept when the serialization threw, even after the stream is destroyed
+        {
+            Failing failing;
+            REQUIRE_THROWS_AS(failing.Serialize(path, true), std::runtime_error);
+        }
+
+        // the old file is kept when a durable stream is moved over
+        {
+            hbann::Stream stream(path, hbann::StreamUsageType::SERIALIZE, false, true);
+            hbann::StreamWriter(stream).WriteAll(std::string("moved over"));
+            stream = hbann::Stream(path, hbann::StreamUsageType::SERIALIZE, false, true);
+        }
+
+        REQUIRE(countTemporary() == countTemporaryBefore);
+        {
+            hbann::Stream streamRead(path, hbann::StreamUsageType::DESERIALIZE);
+            hbann::StreamReader(streamRead).ReadAll(personRead);
+        }
+        REQUIRE(person == personRead);
+
+        std::filesystem::remove(path);
+    }
+
+    SECTION("IndexedWriter/IndexedReader")
+    {
+        const auto path = std::filesystem::temp_directory_path() / "Streamable.Indexed.bin";
+
+        // more keys than the bloom filter has for a block of words so it has many of them
+        {
+            hbann::IndexedWriter indexedWriter(path);
+            REQUIRE(indexedWriter.Append(std::string("header")) == 0);
+
+            for (uint32_t i = 0; i < 5000; i++)
+            {
+                const Person person{.id = i, .name = std::to_string(i), .emails = {}};
+                indexedWriter.AppendKeyed("user" + std::to_string(i), person);
+            }
+
+            indexedWriter.Close();
+        }
+
+        // an abandoned writer doesn't replace the file
+        try
+        {
+            hbann::IndexedWriter indexedWriter(path);
+            indexedWriter.Append(std::string("abandoned"));
+            throw std::runtime_error("abandoned");
+        }
+        catch (const std::runtime_error &)
+        {
+        }
+
+        hbann::IndexedReader indexedReader(path);
+        REQUIRE(indexedReader.Count() == 5001);
+
+        std::string header{};
+        indexedReader.ReadAt(0, header);
+        REQUIRE(header == "header");
+
+        for (const uint32_t i : {0u, 1u, 1023u, 1024u, 2500u, 4999u})
+        {
+            const auto index = indexedReader.Find("user" + std::to_string(i));
+            REQUIRE(index == i + 1);
+
+            std::string key{};
+            Person person{};
+            indexedReader.ReadAt(*index, key, person);
+            REQUIRE(key == "user" + std::to_string(i));
+            REQUIRE(person.id == i);
+        }
+
+        REQUIRE(!indexedReader.Find(std::string("user5000")));
+        REQUIRE(!indexedReader.Find(std::string("header")));
+        REQUIRE(!indexedReader.Find(uint32_t(7)));
+        REQUIRE(!indexedReader.ReadAt(5001, header));
+
+        // the counts of a corrupted footer that would overflow the size of the index are not trusted
+        {
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(-32, std::ios::end);
+
+            const auto count = std::numeric_limits<uint64_t>::max() / 8 + 2;
+            file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+        }
+
+        hbann::IndexedReader indexedReaderCorrupted(path);
+        REQUIRE(indexedReaderCorrupted.Count() == 0);
+        REQUIRE(!indexedReaderCorrupted.ReadAt(0, header));
+        REQUIRE(!indexedReaderCorrupted.Find(std::string("user0")));
+
+        std::filesystem::remove(path);
+    }
+
+    SECTION("IndexedWriter/IndexedReader Big Endian")
+    {
+        const auto path = std::filesystem::temp_directory_path() / "Streamable.Indexed.Big.bin";
+
+        {
+            hbann::BasicIndexedWriter<hbann::SizeFixed, std::endian::big> indexedWriter(path);
+            for (uint64_t i = 0; i < 100; i++)
+            {
+                indexedWriter.AppendKeyed(i * i, double(i) / 2);
+            }
+
+            indexedWriter.Close();
+        }
+
+        hbann::BasicIndexedReader<hbann::SizeFixed, std::endian::big> indexedReader(path);
+        REQUIRE(indexedReader.Count() == 100);
+
+        const auto index = indexedReader.Find(uint64_t(49));
+        REQUIRE(index == 7);
+
+        uint64_t key{};
+        double d{};
+        indexedReader.ReadAt(*index, key, d);
+        REQUIRE(key == 49);
+        REQUIRE(d == 3.5);
+
+        REQUIRE(!indexedReader.Find(uint64_t(50)));
+    }
+
+    SECTION("Checksum")
+    {
+        std::vector<uint32_t> numbers(10000);
+        std::iota(numbers.begin(), numbers.end(), 0u);
+        const Person person{.id = 7, .name = "HBann", .emails = {"a@b.c"}};
+
+        auto bytes = hbann::SerializeChecked(numbers, person);
+        REQUIRE(bytes.size() == hbann::Serialize(numbers, person).size() + sizeof(uint32_t));
+
+        std::vector<uint32_t> numbersRead{};
+        Person personRead{};
+        REQUIRE(hbann::DeserializeIntoChecked(bytes, numbersRead, personRead));
+        REQUIRE(numbers == numbersRead);
+        REQUIRE(person == personRead);
+
+        // a flipped bit or a missing byte is found
+        bytes[1234] ^= 0x10;
+        REQUIRE(!hbann::DeserializeIntoChecked(bytes, numbersRead, personRead));
+        bytes[1234] ^= 0x10;
+        REQUIRE(!hbann::DeserializeIntoChecked(std::span(bytes).first(bytes.size() - 1), numbersRead, personRead));
+
+        // the files are verified while they are read with the big ranges read straight into the objects
+        const auto path = std::filesystem::temp_directory_path() / "Streamable.Checksum.bin";
+        std::vector<uint64_t> numbersBig(hbann::StreamFile::BUFFER_SIZE);
+        std::iota(numbersBig.begin(), numbersBig.end(), 0ull);
+        {
+            hbann::Stream stream(path, hbann::StreamUsageType::SERIALIZE);
+            stream.BeginChecksum();
+            hbann::StreamWriter(stream).WriteAll(numbersBig, const_cast<Person &>(person));
+            stream.WriteChecksum();
+        }
+
+        std::vector<uint64_t> numbersBigRead{};
+        hbann::Stream stream(path, hbann::StreamUsageType::DESERIALIZE);
+        stream.BeginChecksum();
+        hbann::StreamReader(stream).ReadAll(numbersBigRead, personRead);
+        REQUIRE(stream.ReadChecksum());
+        stream.Clear(true);
+
+        REQUIRE(numbersBig == numbersBigRead);
+        REQUIRE(person == personRead);
+    }
+
+    SECTION("StreamGather")
+    {
+        std::vector<uint8_t> bytes(hbann::StreamGather::THRESHOLD);
+        std::iota(bytes.begin(), bytes.end(), uint8_t(0));
+        Person person{.id = 7, .name = std::string(hbann::StreamGather::THRESHOLD, 'x'), .emails = {"a@b.c"}};
+
+        hbann::Stream stream(hbann::StreamGather{});
+        hbann::StreamWriter(stream).WriteAll(uint8_t(1), bytes, person,
+                                             std::string(hbann::StreamGather::THRESHOLD * 2, 'y'));
+
+        // the fields are referenced but the temporaries are copied
+        const auto &spans = stream.Gather();
+        REQUIRE(std::ranges::any_of(spans, [&](const auto aSpan) { return aSpan.data() == bytes.data(); }));
+        const auto name = reinterpret_cast<const uint8_t *>(person.name.data());
+        REQUIRE(std::ranges::any_of(spans, [&](const auto aSpan) { return aSpan.data() == name; }));
+        REQUIRE(std::ranges::count_if(spans, [](const auto aSpan) {
+                    return aSpan.size() == hbann::StreamGather::THRESHOLD;
+                }) == 2);
+
+        const auto bytesSerialized = stream.Release();
+        REQUIRE(bytesSerialized == hbann::Serialize(uint8_t(1), bytes, person,
+                                                    std::string(hbann::StreamGather::THRESHOLD * 2, 'y')));
+    }
+
+    SECTION("StreamCompressed")
+    {
+        // a snapshot that is a few times compressible
+        std::vector<Person> persons{};
+        for (uint32_t i = 0; i < 2000; i++)
+        {
+            persons.push_back({.id = i, .height = 1.5 + (i % 50) / 100., .name = "Person " + std::to_string(i % 100),
+                               .emails = {"person" + std::to_string(i) + "@mail.com"}});
+        }
+        std::vector<uint32_t> numbers(hbann::StreamCompressed::CHUNK_SIZE);
+        std::ranges::generate(numbers, [i = 0u]() mutable { return i++ % 1000; });
+
+        const auto bytes = hbann::SerializeCompressed(hbann::CompressionType::LZ, persons, numbers);
+        REQUIRE(bytes.size() * 3 < hbann::Serialize(persons, numbers).size());
+
+        std::vector<Person> personsRead{};
+        std::vector<uint32_t> numbersRead{};
+        hbann::DeserializeIntoCompressed(bytes, personsRead, numbersRead);
+        REQUIRE(persons == personsRead);
+        REQUIRE(numbers == numbersRead);
+
+        // the objects cross the chunks that are stored as they are when they don't get smaller
+        for (const auto compressionType : {hbann::CompressionType::NONE, hbann::CompressionType::LZ})
+        {
+            hbann::Stream stream(hbann::StreamCompressed(hbann::Stream(), compressionType, 100));
+            hbann::StreamWriter(stream).WriteAll(persons, numbers);
+
+            const auto bytesChunked = stream.Release();
+            hbann::Stream streamRead(hbann::StreamCompressed(hbann::Stream{std::span<const uint8_t>(bytesChunked)}));
+            hbann::StreamReader(streamRead).ReadAll(personsRead, numbersRead);
+            REQUIRE(streamRead.IsEOS());
+            REQUIRE(persons == personsRead);
+            REQUIRE(numbers == numbersRead);
+        }
+
+        // the files are written and read a chunk at a time
+        const auto path = std::filesystem::temp_directory_path() / "Streamable.Compressed.bin";
+        {
+            hbann::Stream stream(hbann::StreamCompressed(hbann::Stream(path, hbann::StreamUsageType::SERIALIZE)));
+            hbann::StreamWriter(stream).WriteAll(persons);
+            stream.Flush();
+            hbann::StreamWriter(stream).WriteAll(numbers);
+            stream.Clear();
+        }
+        REQUIRE(std::filesystem::file_size(path) * 3 < hbann::Serialize(persons, numbers).size());
+
+        // the streams moved over each other while they are serializing keep their own bytes
+        {
+            hbann::Stream stream(hbann::StreamCompressed(hbann::Stream{}));
+            hbann::Stream streamOther(hbann::StreamCompressed(hbann::Stream{}));
+            hbann::StreamWriter(stream).WriteAll(persons);
+            hbann::StreamWriter(streamOther).WriteAll(numbers);
+            stream = std::move(streamOther);
+
+            std::vector<uint32_t> numbersOther{};
+            hbann::DeserializeIntoCompressed(stream.Release(), numbersOther);
+            REQUIRE(numbers == numbersOther);
+
+            std::vector<Person> personsOther{};
+            hbann::DeserializeIntoCompressed(streamOther.Release(), personsOther);
+            REQUIRE(persons == personsOther);
+        }
+
+        hbann::Stream stream(hbann::StreamCompressed(hbann::Stream(path, hbann::StreamUsageType::DESERIALIZE)));
+        hbann::StreamReader(stream).ReadAll(personsRead, numbersRead);
+        REQUIRE(stream.IsEOS());
+        stream.Clear(true);
+
+        REQUIRE(persons == personsRead);
+        REQUIRE(numbers == numbersRead);
+
+        // a corrupted chunk ends the stream
+        auto bytesCorrupted = bytes;
+        bytesCorrupted[0] = 0xFF;
+        hbann::Stream streamCorrupted(hbann::StreamCompressed(hbann::Stream{std::span<const uint8_t>(bytesCorrupted)}));
+        REQUIRE(streamCorrupted.IsEOS());
+    }
+
+#ifndef _WIN32
+    SECTION("StreamDescriptor")
+    {
+        std::array<int, 2> descriptors{};
+        REQUIRE(!pipe(descriptors.data()));
+
+        // bigger than the buffer and than the pipe so the reads and the writes are partial
+        std::vector<uint32_t> numbers(hbann::StreamDescriptor::BUFFER_SIZE);
+        std::iota(numbers.begin(), numbers.end(), 0u);
+        const Person person{.id = 7, .name = "HBann", .emails = {"a@b.c"}};
+
+        std::thread writer([&] {
+            hbann::Stream stream(descriptors[1], hbann::StreamUsageType::SERIALIZE, true);
+            hbann::StreamWriter streamWriter(stream);
+            for (uint8_t i = 0; i < 100; i++)
+            {
+                streamWriter.WriteAll(i);
+            }
+            streamWriter.WriteAll(numbers, const_cast<Person &>(person), std::string("end"));
+        });
+
+        hbann::Stream stream(descriptors[0], hbann::StreamUsageType::DESERIALIZE, true);
+        hbann::StreamReader streamReader(stream);
+        for (uint8_t i = 0; i < 100; i++)
+        {
+            uint8_t iRead{};
+            streamReader.ReadAll(iRead);
+            REQUIRE(i == iRead);
+        }
+
+        std::vector<uint32_t> numbersRead{};
+        Person personRead{};
+        std::string end{};
+        streamReader.ReadAll(numbersRead, personRead, end);
+        writer.join();
+
+        REQUIRE(numbers == numbersRead);
+        REQUIRE(person == personRead);
+        REQUIRE(end == "end");
+        REQUIRE(stream.IsEOS());
+        REQUIRE(!stream.HasFailed());
+    }
+
+    SECTION("StreamDescriptor Failed")
+    {
+        std::array<int, 2> descriptors{};
+        REQUIRE(!socketpair(AF_UNIX, SOCK_STREAM, 0, descriptors.data()));
+        close(descriptors[1]);
+
+        // the write to the socket closed by the other side fails without raising SIGPIPE
+        hbann::Stream stream(descriptors[0], hbann::StreamUsageType::SERIALIZE, true);
+        hbann::StreamWriter(stream).WriteAll(std::vector<uint8_t>(2 * hbann::StreamDescriptor::BUFFER_SIZE));
+        stream.Flush();
+
+        REQUIRE(stream.HasFailed());
+        REQUIRE(!stream.Sync());
+    }
+#endif // !_WIN32
+
+    SECTION("FileRegion")
+    {
+        const auto directory = std::filesystem::temp_directory_path();
+        const auto path = directory / "Streamable.FileRegion.bin";
+        const auto pathArchive = directory / "Streamable.FileRegion.Archive.bin";
+        const auto pathCopy = directory / "Streamable.FileRegion.Copy.bin";
+
+        const auto readFile = [](const std::filesystem::path &aPath) {
+            std::ifstream file(aPath, std::ios::binary);
+            return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), {});
+        };
+
+        // bigger than the buffers so the bytes copied when the kernel can't move them go through them many times
+        std::vector<uint8_t> bytes(3 * hbann::StreamFile::BUFFER_SIZE + 7);
+        std::iota(bytes.begin(), bytes.end(), uint8_t(0));
+        std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+
+        // the region is serialized like its bytes
+        std::string name("artifact");
+        hbann::FileRegion fileRegion(path, 5);
+        hbann::Stream stream;
+        hbann::StreamWriter(stream).WriteAll(name, fileRegion);
+
+        std::vector<uint8_t> bytesRegion(bytes.begin() + 5, bytes.end());
+        REQUIRE(std::ranges::equal(stream.View(), hbann::Serialize(name, bytesRegion)));
+        REQUIRE(fileRegion.GetSize() == bytesRegion.size());
+
+        {
+            hbann::Stream streamArchive(pathArchive, hbann::StreamUsageType::SERIALIZE);
+            hbann::FileRegion fileRegionAll(path);
+            hbann::StreamWriter(streamArchive).WriteAll(name, fileRegion, fileRegionAll, std::string("end"));
+        }
+
+        std::string nameRead{}, end{};
+        hbann::FileRegion fileRegionCopy(pathCopy), fileRegionCopyAfter(pathCopy, bytesRegion.size());
+        hbann::Stream streamArchive(pathArchive, hbann::StreamUsageType::DESERIALIZE);
+        hbann::StreamReader(streamArchive).ReadAll(nameRead, fileRegionCopy, fileRegionCopyAfter, end);
+        REQUIRE(streamArchive.IsEOS());
+        streamArchive.Clear(true);
+
+        auto bytesCopy = readFile(pathCopy);
+        REQUIRE(name == nameRead);
+        REQUIRE(end == "end");
+        REQUIRE(std::ranges::equal(std::span(bytesCopy).first(bytesRegion.size()), bytesRegion));
+        REQUIRE(std::ranges::equal(std::span(bytesCopy).subspan(bytesRegion.size()), bytes));
+
+#ifndef _WIN32
+        std::filesystem::remove(pathCopy);
+
+        std::array<int, 2> descriptors{};
+        REQUIRE(!pipe(descriptors.data()));
+
+        std::thread writer([&] {
+            hbann::Stream streamPipe(descriptors[1], hbann::StreamUsageType::SERIALIZE, true);
+            hbann::StreamWriter(streamPipe).WriteAll(name, fileRegion, std::string("end"));
+        });
+
+        hbann::Stream streamPipe(descriptors[0], hbann::StreamUsageType::DESERIALIZE, true);
+        hbann::StreamReader(streamPipe).ReadAll(nameRead, fileRegionCopy, end);
+        writer.join();
+
+        bytesCopy = readFile(pathCopy);
+        REQUIRE(bytesCopy == bytesRegion);
+        REQUIRE(end == "end");
+        REQUIRE(streamPipe.IsEOS());
+#endif // !_WIN32
+
+        // the rest of the file is measured again after it grew
+        hbann::FileRegion fileRegionGrowing(path);
+        hbann::Stream streamGrowing;
+        hbann::StreamWriter(streamGrowing).WriteAll(fileRegionGrowing);
+        REQUIRE(fileRegionGrowing.GetSize() == bytes.size());
+
+        std::ofstream(path, std::ios::binary | std::ios::app).write("grown", 5);
+        hbann::StreamWriter(streamGrowing).WriteAll(fileRegionGrowing);
+        REQUIRE(fileRegionGrowing.GetSize() == bytes.size() + 5);
+
+        std::filesystem::remove(path);
+        std::filesystem::remove(pathCopy);
+    }
 }
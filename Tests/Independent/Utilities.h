@@ -1,5 +1,46 @@
 #pragma once
 
+struct Quote : public hbann::IStreamable
+{
+    STREAMABLE_DEFINE(Quote, price, quantity)
+
+  public:
+    double price{};
+    int32_t quantity{};
+};
+
+struct Tick : public Quote
+{
+    STREAMABLE_DEFINE_BASE(Quote)
+    STREAMABLE_DEFINE(Tick, id, symbol, bids, side, last)
+
+  public:
+    uint64_t id{};
+    std::array<char, 8> symbol{};
+    std::array<Quote, 2> bids{};
+    std::pair<bool, uint16_t> side{};
+    std::optional<Quote> last{};
+};
+
+struct Trade : public hbann::IStreamable
+{
+    STREAMABLE_DEFINE(Trade, id, tick, venue)
+
+  public:
+    uint64_t id{};
+    Tick tick{};
+    std::variant<int32_t, float> venue{};
+};
+
+struct Order : public hbann::IStreamable
+{
+    STREAMABLE_DEFINE(Order, id, client)
+
+  public:
+    uint64_t id{};
+    std::string client{};
+};
+
 TEST_CASE("Streamable::Independent::Utilities", "[Streamable][Independent][Utilities]")
 {
     SECTION("SizeFinder")
@@ -43,4 +84,236 @@ TEST_CASE("Streamable::Independent::Utilities", "[Streamable][Independent][Utili
             }
         }
     }
+    SECTION("SizeFinder Serialized Size")
+    {
+        using namespace hbann;
+
+        static_assert(exact_serialized_size<Quote> == sizeof(double) + sizeof(int32_t));
+        static_assert(max_serialized_size<Trade, SizeFixed> == 8 + 4 + max_serialized_size<Tick, SizeFixed> + 4 + 4);
+        static_assert(is_serialized_size_bounded<Tick> && !is_serialized_size_exact<Tick>);
+        static_assert(!is_serialized_size_bounded<Order> && !is_serialized_size_bounded<std::vector<int>>);
+        static_assert(exact_serialized_size<std::array<std::array<float, 3>, 2>> == 1 + 24);
+
+        Tick tick{};
+        tick.price = 12.34;
+        tick.id = 42;
+        tick.symbol = {'C', 'A', 'R', 'I'};
+        tick.bids[1].quantity = 7;
+        tick.side = {true, 3};
+
+        std::array<uint8_t, max_serialized_size<Tick>> buffer{};
+        const auto sizeWithout = tick.Serialize(buffer);
+        REQUIRE(sizeWithout == max_serialized_size<Tick> - exact_serialized_size<Quote> - 1);
+
+        tick.last = Quote{};
+        const auto size = tick.Serialize(buffer);
+        REQUIRE(size == max_serialized_size<Tick>);
+
+        // the buffer that is too small is not written after its end
+        std::array<uint8_t, max_serialized_size<Tick> + 1> bufferSmall{};
+        REQUIRE(!tick.Serialize(std::span(bufferSmall).first(max_serialized_size<Tick> - 1)));
+        REQUIRE(!tick.Serialize(std::span(bufferSmall).first(8)));
+        REQUIRE(bufferSmall.back() == 0);
+
+        Tick tickEnd{};
+        tickEnd.Deserialize(Stream(std::span<const uint8_t>(buffer.data(), *size)));
+
+        REQUIRE(tickEnd.price == tick.price);
+        REQUIRE(tickEnd.id == tick.id);
+        REQUIRE(tickEnd.symbol == tick.symbol);
+        REQUIRE(tickEnd.bids[1].quantity == tick.bids[1].quantity);
+        REQUIRE(tickEnd.side == tick.side);
+        REQUIRE(tickEnd.last.has_value());
+    }
+    SECTION("XorCompressor")
+    {
+        const std::vector<double> values{0., 0., 12.5, 12.5, 12.75, -1e300, 1e-300, 3.14159, 3.14159, 0.};
+        const auto bytes = hbann::XorCompressor::Encode(std::span<const double>(values));
+
+        std::vector<double> valuesDecoded(values.size());
+        REQUIRE(hbann::XorCompressor::Decode(bytes, std::span<double>(valuesDecoded)) == values.size());
+        REQUIRE(values == valuesDecoded);
+
+        // a window of 15 leading zeros and 32 meaningful bits doesn't fit in a float
+        hbann::BitWriter bitWriter;
+        bitWriter.Write(std::bit_cast<uint32_t>(1.5f), 32);
+        bitWriter.Write(0b11, 2);
+        bitWriter.Write(15, 4);
+        bitWriter.Write(31, 5);
+        bitWriter.Write(0xFFFFFFFF, 32);
+
+        std::vector<float> valuesCorrupted(2);
+        REQUIRE(hbann::XorCompressor::Decode(bitWriter.Release(), std::span<float>(valuesCorrupted)) == 1);
+        REQUIRE(valuesCorrupted.front() == 1.5f);
+
+        const std::vector<float> empty{};
+        REQUIRE(hbann::XorCompressor::Encode(std::span<const float>(empty)).empty());
+    }
+    SECTION("LzCompressor")
+    {
+        const auto roundTrip = [](const std::vector<uint8_t> &aBytes) {
+            std::vector<uint8_t> encoded{};
+            hbann::LzCompressor::Encode(aBytes, encoded);
+            REQUIRE(encoded.size() <= hbann::LzCompressor::GetBound(aBytes.size()));
+
+            std::vector<uint8_t> decoded(aBytes.size());
+            REQUIRE(hbann::LzCompressor::Decode(encoded, decoded));
+            REQUIRE(aBytes == decoded);
+
+            return encoded;
+        };
+
+        roundTrip({});
+        roundTrip({1, 2, 3});
+        REQUIRE(roundTrip(std::vector<uint8_t>(100000)).size() < 500);
+
+        // the text repeats with changes and the noise can't be compressed
+        std::string text{};
+        for (auto i = 0; i < 5000; i++)
+        {
+            text += "{\"id\":" + std::to_string(i) + ",\"name\":\"sensor-" + std::to_string(i % 37) + "\",\"ok\":true}";
+        }
+        const std::vector<uint8_t> bytes(text.begin(), text.end());
+        REQUIRE(roundTrip(bytes).size() * 4 < bytes.size());
+
+        std::vector<uint8_t> noise(100000);
+        std::ranges::generate(noise, [i = 0u]() mutable { return static_cast<uint8_t>(i++ * 2654435761u >> 24); });
+        REQUIRE(roundTrip(noise).size() <= hbann::LzCompressor::GetBound(noise.size()));
+
+        // the corrupted bytes are found without reading or writing out of bounds
+        std::vector<uint8_t> encoded{};
+        hbann::LzCompressor::Encode(bytes, encoded);
+        std::vector<uint8_t> decoded(bytes.size());
+        REQUIRE(!hbann::LzCompressor::Decode(std::span(encoded).first(encoded.size() / 2), decoded));
+        REQUIRE(!hbann::LzCompressor::Decode(encoded, std::span(decoded).first(decoded.size() - 1)));
+        for (size_t i = 0; i < encoded.size(); i += 7)
+        {
+            encoded[i] ^= 0xA5;
+        }
+        (void)hbann::LzCompressor::Decode(encoded, decoded);
+    }
+    SECTION("FloatConverter")
+    {
+        using hbann::FloatConverter;
+
+        REQUIRE(FloatConverter::ToFloat16(1.f) == 0x3C00);
+        REQUIRE(FloatConverter::ToFloat16(-2.f) == 0xC000);
+        REQUIRE(FloatConverter::ToFloat16(65504.f) == 0x7BFF);
+        REQUIRE(FloatConverter::ToFloat16(1e6f) == 0x7C00);
+        REQUIRE(FloatConverter::ToFloat16(5.960464477539063e-8f) == 0x0001);
+        REQUIRE(FloatConverter::FromFloat16(0x0001) == 5.960464477539063e-8f);
+        REQUIRE(FloatConverter::FromFloat16(0x3555) == 0.333251953125f);
+        REQUIRE(std::isnan(FloatConverter::FromFloat16(FloatConverter::ToFloat16(NAN))));
+
+        REQUIRE(FloatConverter::ToBFloat16(1.f) == 0x3F80);
+
+        // the doubles just above the halfway between two float16/bfloat16 are rounded to the float between them first
+        REQUIRE(FloatConverter::ToFloat16(1. + 0x1p-11 + 0x1p-40) == 0x3C01);
+        REQUIRE(FloatConverter::ToBFloat16(1. + 0x1p-8 + 0x1p-40) == 0x3F81);
+        REQUIRE(FloatConverter::ToFloat16(-1. - 0x1p-11 + 0x1p-40) == 0xBC00);
+        REQUIRE(FloatConverter::ToFloat16(1e300) == 0x7C00);
+        REQUIRE(FloatConverter::ToFloat16(1e-300) == 0x0000);
+        REQUIRE(std::isnan(FloatConverter::FromBFloat16(FloatConverter::ToBFloat16(std::nan("")))));
+        REQUIRE(FloatConverter::FromBFloat16(0xC040) == -3.f);
+
+        std::vector<float> floats(19);
+        for (size_t i = 0; i < floats.size(); i++)
+        {
+            floats[i] = static_cast<float>(i) / 3.f - 2.f;
+        }
+
+        std::vector<uint16_t> halfs(floats.size());
+        FloatConverter::ToFloat16(std::span<const float>(floats), std::span(halfs));
+        for (size_t i = 0; i < floats.size(); i++)
+        {
+            REQUIRE(halfs[i] == FloatConverter::ToFloat16(floats[i]));
+        }
+
+        std::vector<float> floatsDecoded(floats.size());
+        FloatConverter::FromFloat16(std::span<const uint16_t>(halfs), std::span(floatsDecoded));
+        for (size_t i = 0; i < floats.size(); i++)
+        {
+            REQUIRE(floatsDecoded[i] == FloatConverter::FromFloat16(halfs[i]));
+        }
+
+        REQUIRE(FloatConverter::Quantize(-10., 8, -1., 1.) == 0);
+        REQUIRE(FloatConverter::Quantize(10., 8, -1., 1.) == 255);
+        REQUIRE(FloatConverter::Quantize(std::nan(""), 8, -1., 1.) == 0);
+        REQUIRE(FloatConverter::Dequantize(255, 8, -1., 1.) == 1.);
+    }
+    SECTION("Size")
+    {
+        ForEachSizeType([]<typename SizeType>(const SizeType &) {
+            for (const hbann::Size::size_max size :
+                 {0ull, 1ull, 31ull, 32ull, 127ull, 128ull, 8191ull, 16383ull, 16384ull, 65535ull, 0xFFFFFFFFull})
+            {
+                const auto bytes = SizeType::MakeSize(size);
+                const auto span = static_cast<hbann::Size::span>(bytes);
+
+                REQUIRE(span.size() == SizeType::FindRequiredBytes(size));
+                REQUIRE(SizeType::FindRequiredBytes(span.front()) == span.size());
+                REQUIRE(SizeType::MakeSize(span) == size);
+            }
+        });
+
+        REQUIRE(hbann::Size::MakeSize(31).count == 1);
+        REQUIRE(hbann::SizeVarint::MakeSize(127).count == 1);
+        REQUIRE(hbann::SizeVarint::MakeSize(128).count == 2);
+        REQUIRE(hbann::SizeVarint::MakeSize(SIZE_MAX).count == 9);
+        REQUIRE(hbann::SizeVarint::MakeSize(hbann::SizeVarint::MakeSize(SIZE_MAX)) == SIZE_MAX);
+
+        // the sizes that don't fit in the fixed size are not truncated
+        REQUIRE_THROWS_AS(hbann::SizeFixed::MakeSize(0x1'0000'0000ull), std::length_error);
+    }
+    SECTION("Crc32c")
+    {
+        const auto asBytes = [](const std::string_view aString) {
+            return std::span(reinterpret_cast<const uint8_t *>(aString.data()), aString.size());
+        };
+
+        REQUIRE(hbann::Crc32c::Extend(0, {}) == 0);
+        REQUIRE(hbann::Crc32c::Extend(0, asBytes("123456789")) == 0xE3069283);
+        REQUIRE(hbann::Crc32c::Extend(0, std::vector<uint8_t>(32)) == 0x8A9136AA);
+        REQUIRE(hbann::Crc32c::Extend(0, std::vector<uint8_t>(32, 0xFF)) == 0x62A8AB43);
+
+        // the CRC computed in parts of any size and alignment is the same (the long ones are computed in parallel)
+        std::vector<uint8_t> bytes(100000);
+        std::ranges::generate(bytes, [i = 0u]() mutable { return static_cast<uint8_t>(i++ * 2654435761u >> 24); });
+        const auto crc = hbann::Crc32c::Extend(0, bytes);
+        for (const auto split : {1, 3, 8, 13, 999, 30000})
+        {
+            const auto first = std::span(bytes).first(split);
+            REQUIRE(hbann::Crc32c::Extend(hbann::Crc32c::Extend(0, first), std::span(bytes).subspan(split)) == crc);
+        }
+
+        uint32_t crcParts{};
+        for (size_t i = 0; i < bytes.size(); i += 100)
+        {
+            crcParts = hbann::Crc32c::Extend(crcParts, std::span(bytes).subspan(i, 100));
+        }
+        REQUIRE(crcParts == crc);
+    }
+
+    SECTION("ByteSwapper")
+    {
+        using namespace hbann;
+
+        REQUIRE(ByteSwapper::Swap(uint16_t(0x0102)) == 0x0201);
+        REQUIRE(ByteSwapper::Swap(uint32_t(0x01020304)) == 0x04030201);
+        REQUIRE(ByteSwapper::Swap(uint64_t(0x0102030405060708)) == 0x0807060504030201);
+        REQUIRE(ByteSwapper::Swap(ByteSwapper::Swap(-12.34)) == -12.34);
+
+        // more than a vector and a tail
+        std::vector<uint32_t> values(37);
+        std::iota(values.begin(), values.end(), 0x01020300);
+        std::vector<uint32_t> swapped(values.size());
+        ByteSwapper::Swap(std::span<const uint32_t>(values), std::span<uint32_t>(swapped));
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            REQUIRE(swapped[i] == ByteSwapper::Swap(values[i]));
+        }
+
+        ByteSwapper::Swap(std::span<uint32_t>(swapped));
+        REQUIRE(swapped == values);
+    }
 }
@@ -1,6 +1,8 @@
 #include "pch.h"
 #include "Utilities/Classes.h"
+#include "Utilities/Policies.h"
 
+#include "Independent/Attributes.h"
 #include "Independent/Streams.h"
 #include "Independent/Utilities.h"
 
@@ -85,6 +87,134 @@ TEST_CASE("IStreamable", "[IStreamable]")
 
         REQUIRE(contextStart == contextEnd);
     }
+
+    SECTION("Durable")
+    {
+        const auto path = std::filesystem::temp_directory_path() / "Streamable.Circle.bin";
+
+        Circle circleStart(GUID_RND, "SVG", L"URL\\SHIT", std::vector{69., 420.});
+        circleStart.Serialize(path, true);
+        REQUIRE(std::ranges::none_of(std::filesystem::directory_iterator(path.parent_path()), [&](const auto &aEntry) {
+            return aEntry.path().filename().string().starts_with(path.filename().string() + ".");
+        }));
+
+        Circle circleEnd;
+        circleEnd.Deserialize(path, true);
+        REQUIRE(circleStart == circleEnd);
+    }
+
+    SECTION("Gather")
+    {
+        // the big strings of the streamable and of the nested ones are referenced
+        const std::string svg(hbann::StreamGather::THRESHOLD * 4, 'x');
+        Circle circle(GUID_RND, svg, L"URL\\SHIT", std::vector{69., 420.});
+        Sphere sphere(circle, std::make_unique<bool>(true), {"Commit: added tuple support", {22, 100}}, {circle, 22.});
+
+        auto stream = sphere.SerializeGather();
+        const auto &spans = stream.Gather();
+        REQUIRE(std::ranges::count_if(spans, [&](const auto aSpan) { return aSpan.size() == svg.size(); }) == 2);
+
+        const auto bytes = stream.Release();
+        REQUIRE(std::ranges::equal(bytes, sphere.Serialize().View()));
+
+        Sphere sphereEnd;
+        sphereEnd.Deserialize(hbann::Stream(std::span<const uint8_t>(bytes)));
+        REQUIRE(sphere == sphereEnd);
+    }
+
+    SECTION("Compressed")
+    {
+        // the pointers to the base class peek their type in the decompressed bytes
+        auto shapes = std::make_shared<std::vector<Shape *>>();
+        for (auto i = 0; i < 100; i++)
+        {
+            shapes->push_back(new Circle(GUID_RND, std::string(1000, 'x'), "Circle_URL", std::vector{420., 69.}));
+        }
+        ::Context contextStart(std::move(shapes));
+
+        hbann::Stream stream(hbann::StreamCompressed(hbann::Stream{}));
+        hbann::StreamWriter(stream).WriteAll(contextStart);
+        const auto bytes = stream.Release();
+        REQUIRE(bytes.size() * 4 < contextStart.Serialize().View().size());
+
+        ::Context contextEnd;
+        hbann::Stream streamRead(hbann::StreamCompressed(hbann::Stream{std::span<const uint8_t>(bytes)}));
+        hbann::StreamReader(streamRead).ReadAll(contextEnd);
+        REQUIRE(contextStart == contextEnd);
+    }
+}
+
+TEST_CASE("StaticStreamable", "[StaticStreamable]")
+{
+    SECTION("Simple")
+    {
+        StaticShape shapeStart(Shape::Type::RECTANGLE, GUID_RND);
+        StaticShape shapeEnd{};
+        shapeEnd.Deserialize(shapeStart.Serialize());
+
+        REQUIRE(shapeStart == shapeEnd);
+    }
+
+    SECTION("Derived++")
+    {
+        StaticCircle circle(GUID_RND, "SVG", L"URL\\SHIT", std::vector{69., 420.});
+        StaticSphere sphereStart(circle, std::make_unique<bool>(true), {"Commit: added tuple support", {22, 100}},
+                                 {circle, 22.});
+        StaticSphere sphereEnd;
+        sphereEnd.Deserialize(sphereStart.Serialize());
+
+        REQUIRE(sphereStart == sphereEnd);
+    }
+
+    SECTION("Same Format As IStreamable")
+    {
+        Circle circle(GUID_RND, "SVG", L"URL\\SHIT", std::vector{69., 420.});
+        Sphere sphere(circle, std::make_unique<bool>(true), {"Commit: added tuple support", {22, 100}}, {circle, 22.});
+
+        StaticCircle circleStatic(GUID_RND, "SVG", L"URL\\SHIT", std::vector{69., 420.});
+        StaticSphere sphereStatic(circleStatic, std::make_unique<bool>(true), {"Commit: added tuple support", {22, 100}},
+                                  {circleStatic, 22.});
+
+        auto stream = sphere.Serialize();
+        auto streamStatic = sphereStatic.Serialize();
+
+        const auto view = stream.View();
+        const auto viewStatic = streamStatic.View();
+        REQUIRE(std::ranges::equal(view, viewStatic));
+
+        StaticSphere sphereEnd;
+        sphereEnd.Deserialize(hbann::Stream(view));
+
+        REQUIRE(sphereStatic == sphereEnd);
+    }
+
+    SECTION("Nested Same Format As IStreamable")
+    {
+        // the size of the circle needs more bytes than the smallest one and the size of the shape is known
+        const guid id = GUID_RND;
+        const std::string svg(300, 'S');
+        Circle circle(id, svg, L"URL\\SHIT", std::vector{69., 420.});
+        Shape shape(Shape::Type::RECTANGLE, id);
+
+        StaticCircle circleStatic(id, svg, L"URL\\SHIT", std::vector{69., 420.});
+        StaticShape shapeStatic(Shape::Type::RECTANGLE, id);
+
+        const auto bytes = hbann::Serialize(circle, shape);
+        REQUIRE(std::ranges::equal(bytes, hbann::Serialize(circleStatic, shapeStatic)));
+        REQUIRE(std::ranges::equal(hbann::SerializeChecked(circle, shape),
+                                   hbann::SerializeChecked(circleStatic, shapeStatic)));
+
+        std::vector<uint8_t> buffer(bytes.size());
+        REQUIRE(hbann::SerializeInto(buffer, circleStatic, shapeStatic) == bytes.size());
+        REQUIRE(buffer == bytes);
+        REQUIRE(!hbann::SerializeInto(std::span(buffer).first(bytes.size() - 1), circleStatic, shapeStatic));
+
+        StaticCircle circleEnd;
+        StaticShape shapeEnd;
+        hbann::DeserializeInto(bytes, circleEnd, shapeEnd);
+        REQUIRE(circleStatic == circleEnd);
+        REQUIRE(shapeStatic == shapeEnd);
+    }
 }
 
 int main(int argc, char **argv)
@@ -205,3 +205,73 @@ class Context : public hbann::IStreamable
   private:
     std::shared_ptr<std::vector<Shape *>> mShapes{};
 };
+
+class StaticShape : public hbann::StaticStreamable
+{
+    STREAMABLE_DEFINE_STATIC(StaticShape, mType, mID)
+
+  public:
+    StaticShape() = default;
+    StaticShape(const Shape::Type aType, const guid &aID) : mType(aType), mID(aID)
+    {
+    }
+
+    bool operator==(const StaticShape &aShape) const
+    {
+        return mType == aShape.mType && !memcmp(&mID, &aShape.mID, sizeof(mID));
+    }
+
+  private:
+    Shape::Type mType = Shape::Type::NONE;
+    guid mID{};
+};
+
+class StaticCircle : public StaticShape
+{
+    STREAMABLE_DEFINE_STATIC_BASE(StaticShape)
+    STREAMABLE_DEFINE_STATIC(StaticCircle, mSVG, mURL, mVariant)
+
+  public:
+    StaticCircle() = default;
+    StaticCircle(const guid &aID, const std::optional<std::string> &aSVG, const std::filesystem::path &aURL,
+                 std::variant<std::vector<double>, bool> &&aVariant)
+        : StaticShape(Shape::Type::CIRCLE, aID), mSVG(aSVG), mURL(aURL), mVariant(aVariant)
+    {
+    }
+
+    bool operator==(const StaticCircle &aCircle) const
+    {
+        return *(StaticShape *)this == *(StaticShape *)&aCircle && mSVG == aCircle.mSVG && mURL == aCircle.mURL &&
+               mVariant == aCircle.mVariant;
+    }
+
+  private:
+    std::optional<std::string> mSVG{};
+    std::filesystem::path mURL{};
+    std::variant<std::vector<double>, bool> mVariant{};
+};
+
+class StaticSphere : public StaticCircle
+{
+    STREAMABLE_DEFINE_STATIC_BASE(StaticCircle)
+    STREAMABLE_DEFINE_STATIC(StaticSphere, mReflexion, mTuple, mPair)
+
+  public:
+    StaticSphere() = default;
+    StaticSphere(const StaticCircle &aCircle, std::unique_ptr<bool> &&aReflexion,
+                 std::tuple<std::string, std::list<int>> &&aTuple, std::pair<StaticCircle, double> &&aPair)
+        : StaticCircle(aCircle), mReflexion(std::move(aReflexion)), mTuple(std::move(aTuple)), mPair(std::move(aPair))
+    {
+    }
+
+    bool operator==(const StaticSphere &aSphere) const
+    {
+        return *(StaticCircle *)this == *(StaticCircle *)&aSphere && *mReflexion == *aSphere.mReflexion &&
+               mTuple == aSphere.mTuple && mPair == aSphere.mPair;
+    }
+
+  private:
+    std::unique_ptr<bool> mReflexion{};
+    std::tuple<std::string, std::list<int>> mTuple{};
+    std::pair<StaticCircle, double> mPair{};
+};
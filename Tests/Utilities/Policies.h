@@ -0,0 +1,16 @@
+#pragma once
+
+// calls the function with every size policy so a test runs for all of them
+template <typename Function> void ForEachSizeType(Function &&aFunction)
+{
+    aFunction(hbann::Size{});
+    aFunction(hbann::SizeFixed{});
+    aFunction(hbann::SizeVarint{});
+}
+
+// calls the function with both endiannesses so a test runs for the native one and the swapped one
+template <typename Function> void ForEachEndian(Function &&aFunction)
+{
+    aFunction(std::integral_constant<std::endian, std::endian::little>{});
+    aFunction(std::integral_constant<std::endian, std::endian::big>{});
+}
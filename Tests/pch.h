@@ -22,6 +22,15 @@ using namespace Catch;
 // Test
 #include <iostream>
 #include <list>
+#include <map>
+#include <set>
+#include <numeric>
+#include <thread>
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/resource.h>
+#endif // _WIN32
 
 /*
     TODO: